@@ -0,0 +1,157 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/bench/columnarCheck.cc
+/// \brief Round-trip check of the columnar output format
+///
+/// A file is written with B1::ColumnarFile in small chunks, continued in
+/// append mode, and read back with B1::ColumnarReader; every value, the
+/// number of rows and the chunk layout are compared with what was
+/// written. Returns a non-zero status on the first mismatch.
+///
+/// Usage: columnarCheck [fileName]
+
+#include "ColumnarFile.hh"
+#include "ColumnarReader.hh"
+
+#include <cstdio>
+#include <exception>
+#include <iostream>
+
+using namespace B1;
+
+namespace
+{
+
+const std::size_t kChunkRows = 7;
+const std::size_t kRowsPerPass = 20;  // not a multiple of kChunkRows
+const G4int kNofPasses = 2;  // write, then append
+
+// Values of row i of the file
+G4double Energy(std::size_t i) { return 0.5 * i + 1.; }
+G4int PMT(std::size_t i) { return static_cast<G4int>(i % 13) - 1; }
+G4float Sample(std::size_t i, std::size_t k) { return static_cast<G4float>(3 * i + k); }
+
+G4bool Write(const G4String& fileName)
+{
+  for (G4int pass = 0; pass < kNofPasses; ++pass) {
+    ColumnarFile file;
+    file.AddColumn("Energy", columnar::ColumnType::kFloat64);
+    file.AddColumn("PMT", columnar::ColumnType::kInt32);
+    file.AddColumn("Samples", columnar::ColumnType::kFloat32, 3);
+    file.SetChunkRows(kChunkRows);
+    if (!file.Open(fileName, pass > 0)) return false;
+
+    for (std::size_t j = 0; j < kRowsPerPass; ++j) {
+      std::size_t i = pass * kRowsPerPass + j;
+      *file.Extend<G4double>(0, 1) = Energy(i);
+      *file.Extend<G4int>(1, 1) = PMT(i);
+      auto samples = file.Extend<G4float>(2, 1);
+      for (std::size_t k = 0; k < 3; ++k) samples[k] = Sample(i, k);
+      file.CommitRows(1);
+    }
+    file.Close();
+  }
+  return true;
+}
+
+G4int Check(const G4String& fileName)
+{
+  ColumnarReader reader(fileName);
+  const std::size_t nofRows = kNofPasses * kRowsPerPass;
+  G4int nofErrors = 0;
+  auto expect = [&nofErrors](G4bool condition, const char* what, std::size_t i) {
+    if (!condition) {
+      std::cerr << " mismatch: " << what << " at " << i << std::endl;
+      ++nofErrors;
+    }
+  };
+
+  expect(reader.GetNofColumns() == 3, "number of columns", 0);
+  expect(reader.GetNofRows() == nofRows, "number of rows", 0);
+  expect(reader.GetColumnCount(reader.GetColumnIndex("Samples")) == 3, "Samples count", 0);
+
+  // every pass ends with a partial chunk
+  const std::size_t chunksPerPass = (kRowsPerPass + kChunkRows - 1) / kChunkRows;
+  expect(reader.GetNofChunks() == kNofPasses * chunksPerPass, "number of chunks", 0);
+
+  std::size_t i = 0;
+  reader.ForEach<G4double>(reader.GetColumnIndex("Energy"), [&](const G4double* v, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k, ++i) expect(v[k] == Energy(i), "Energy", i);
+  });
+  expect(i == nofRows, "Energy rows", i);
+
+  i = 0;
+  reader.ForEach<G4int>(reader.GetColumnIndex("PMT"), [&](const G4int* v, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k, ++i) expect(v[k] == PMT(i), "PMT", i);
+  });
+  expect(i == nofRows, "PMT rows", i);
+
+  i = 0;
+  reader.ForEach<G4float>(reader.GetColumnIndex("Samples"), [&](const G4float* v, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k, ++i) expect(v[k] == Sample(i / 3, i % 3), "Samples", i);
+  });
+  expect(i == 3 * nofRows, "Samples values", i);
+
+  // a column read with the wrong type is refused
+  G4bool refused = false;
+  try {
+    reader.Column<G4float>(0, reader.GetColumnIndex("Energy"));
+  }
+  catch (const std::exception&) {
+    refused = true;
+  }
+  expect(refused, "type check", 0);
+
+  return nofErrors;
+}
+
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  const G4String fileName = (argc > 1) ? argv[1] : "columnarCheck.b1col";
+  std::remove(fileName.c_str());
+
+  G4int nofErrors = 0;
+  try {
+    if (!Write(fileName)) {
+      std::cerr << " cannot write " << fileName << std::endl;
+      return 1;
+    }
+    nofErrors = Check(fileName);
+  }
+  catch (const std::exception& e) {
+    std::cerr << " " << e.what() << std::endl;
+    return 1;
+  }
+  std::remove(fileName.c_str());
+
+  std::cout << " Columnar round trip: " << (nofErrors ? "FAILED" : "passed") << std::endl;
+  return nofErrors ? 1 : 0;
+}
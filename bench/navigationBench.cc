@@ -0,0 +1,199 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/bench/navigationBench.cc
+/// \brief Micro-benchmark of the navigation in PMT arrays
+///
+/// PMT arrays of about 24, 200 and 1000 PMTs are built with
+/// B1::PMTArrayBuilder in a LAB cylinder and straight tracks, starting
+/// inside the target and isotropic, are navigated with a G4Navigator until
+/// they leave the world. Every array is placed:
+///  - flat, every PMT a placement in the LAB volume,
+///  - in envelopes (parameterised PMTs), for several smartless values.
+///
+/// Usage: navigationBench [nofTracks]
+
+#include "PMTArrayBuilder.hh"
+
+#include "G4Box.hh"
+#include "G4GeometryManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4NistManager.hh"
+#include "G4Navigator.hh"
+#include "G4PVPlacement.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4SolidStore.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Tubs.hh"
+#include "Randomize.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+
+using namespace B1;
+
+namespace
+{
+
+struct Result
+{
+    G4int nofPMTs = 0;
+    G4double closeTime = 0.;  // ms
+    G4double stepTime = 0.;  // ns/step
+    std::size_t nofSteps = 0;
+    std::size_t nofPMTSteps = 0;  // steps ending in a PMT
+};
+
+// World of air, LAB cylinder (r = 630 mm, half-length 650 mm) and the PMT
+// array of layout(), placed by builder; then the navigation of nofTracks
+Result Run(PMTArrayBuilder& builder, G4double pmtRadius, G4int nofTracks)
+{
+  G4GeometryManager::GetInstance()->OpenGeometry();
+  G4PhysicalVolumeStore::Clean();
+  G4LogicalVolumeStore::Clean();
+  G4SolidStore::Clean();
+
+  auto nist = G4NistManager::Instance();
+  auto world = new G4LogicalVolume(new G4Box("World", 1. * m, 1. * m, 1. * m),
+                                   nist->FindOrBuildMaterial("G4_AIR"), "World");
+  auto physWorld = new G4PVPlacement(nullptr, G4ThreeVector(), world, "World", nullptr, false, 0);
+  G4Material* lab = nist->FindOrBuildMaterial("G4_TOLUENE");  // stands for LAB
+  auto buffer = new G4LogicalVolume(new G4Tubs("LabBuffer", 0., 630. * mm, 650. * mm, 0., twopi),
+                                    lab, "LabBuffer");
+  new G4PVPlacement(nullptr, G4ThreeVector(), buffer, "LabBuffer", world, false, 0);
+  auto pmt = new G4LogicalVolume(new G4Tubs("PMT", 0., pmtRadius, 2. * mm, 0., twopi),
+                                 nist->FindOrBuildMaterial("G4_Si"), "PMT");
+
+  Result result;
+  result.nofPMTs = builder.Build(pmt, buffer, lab, false);
+  builder.Tune();
+
+  auto start = std::chrono::steady_clock::now();
+  G4GeometryManager::GetInstance()->CloseGeometry(true, false);
+  std::chrono::duration<G4double, std::milli> closeTime = std::chrono::steady_clock::now() - start;
+  result.closeTime = closeTime.count();
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(physWorld);
+
+  // the same tracks for every placement
+  G4Random::setTheSeed(12345);
+  start = std::chrono::steady_clock::now();
+  for (G4int i = 0; i < nofTracks; ++i) {
+    G4double r = 590. * mm * std::sqrt(G4UniformRand());
+    G4double phi = twopi * G4UniformRand();
+    G4ThreeVector position(r * std::cos(phi), r * std::sin(phi),
+                           (2. * G4UniformRand() - 1.) * 340. * mm);
+    G4double cosTheta = 2. * G4UniformRand() - 1.;
+    G4double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+    phi = twopi * G4UniformRand();
+    G4ThreeVector direction(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+
+    G4VPhysicalVolume* volume = navigator.LocateGlobalPointAndSetup(position, &direction, false);
+    for (G4int n = 0; volume && n < 1000; ++n) {
+      G4double safety = 0.;
+      G4double step = navigator.ComputeStep(position, direction, kInfinity, safety);
+      if (step == kInfinity) break;
+      position += step * direction;
+      navigator.SetGeometricallyLimitedStep();
+      volume = navigator.LocateGlobalPointAndSetup(position, &direction, true);
+      ++result.nofSteps;
+      if (volume && volume->GetLogicalVolume() == pmt) ++result.nofPMTSteps;
+    }
+  }
+  std::chrono::duration<G4double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  result.stepTime = elapsed.count() / static_cast<G4double>(result.nofSteps);
+
+  G4GeometryManager::GetInstance()->OpenGeometry();
+  return result;
+}
+
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  const G4int nofTracks = (argc > 1) ? std::atoi(argv[1]) : 20000;
+
+  struct Layout
+  {
+      const char* name;
+      G4double pmtRadius;
+      std::function<void(PMTArrayBuilder&)> define;
+  };
+  const Layout layouts[] = {
+    {"2 rings", 75. * mm,
+     [](PMTArrayBuilder& builder) {
+       builder.AddRing(+400. * mm, 480. * mm, 12);
+       builder.AddRing(-400. * mm, 480. * mm, 12);
+     }},
+    {"caps + wall", 38. * mm,
+     [](PMTArrayBuilder& builder) {
+       builder.AddCap(+400. * mm, 480. * mm, 100. * mm);
+       builder.AddCap(-400. * mm, 480. * mm, 100. * mm);
+       builder.AddWall(615. * mm, -300. * mm, 300. * mm, 4, 20);
+     }},
+    {"dense caps + wall", 15. * mm,
+     [](PMTArrayBuilder& builder) {
+       builder.AddCap(+400. * mm, 560. * mm, 55. * mm);
+       builder.AddCap(-400. * mm, 560. * mm, 55. * mm);
+       builder.AddWall(615. * mm, -300. * mm, 300. * mm, 8, 40);
+     }}};
+  const G4double smartless[] = {0.5, 2., 8.};
+
+  // a single builder: its commands are defined once
+  PMTArrayBuilder builder;
+  G4cout << G4endl << " Navigation of " << nofTracks << " tracks" << G4endl;
+  for (const auto& layout : layouts) {
+    builder.Clear();
+    layout.define(builder);
+
+    auto print = [](const G4String& placement, const Result& result) {
+      G4cout << "  " << placement << ": " << result.stepTime << " ns/step, "
+             << 1.e3 / result.stepTime << " Msteps/s (" << result.nofSteps << " steps, "
+             << result.nofPMTSteps << " in PMTs), voxels " << result.closeTime << " ms"
+             << G4endl;
+    };
+
+    builder.SetUseEnvelopes(false);
+    Result flat = Run(builder, layout.pmtRadius, nofTracks);
+    G4cout << G4endl << " " << layout.name << ": " << flat.nofPMTs << " PMTs" << G4endl;
+    print("flat              ", flat);
+
+    builder.SetUseEnvelopes(true);
+    for (auto value : smartless) {
+      builder.SetSmartless(value);
+      print("envelopes, smartless " + std::to_string(value).substr(0, 3),
+            Run(builder, layout.pmtRadius, nofTracks));
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/bench/physicsListBench.cc
+/// \brief Start-up time and memory of the physics lists
+///
+/// The B1 detector is initialised with the given physics list, then a
+/// first run of one event per thread builds the physics tables and
+/// initialises every worker. The wall time of both steps and the resident
+/// memory (VmRSS, peak VmHWM) are printed. The memory per thread is
+/// estimated by comparing runs with different numbers of threads:
+///   (RSS(N threads) - RSS(1 thread)) / (N - 1)
+///
+/// Usage: physicsListBench [QBBC|slim] [nThreads]
+
+#include "DetectorConstruction.hh"
+#include "PhysicsListFactory.hh"
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4RunManager.hh"
+#include "G4RunManagerFactory.hh"
+#include "G4UImanager.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserActionInitialization.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+using namespace B1;
+
+namespace
+{
+
+// Only the primaries: no output in the benchmark
+class BenchActionInitialization : public G4VUserActionInitialization
+{
+  public:
+    void Build() const override { SetUserAction(new PrimaryGeneratorAction); }
+};
+
+// Value of a field of /proc/self/status, in MB
+G4double ReadStatus(const std::string& field)
+{
+  std::ifstream in("/proc/self/status");
+  for (std::string line; std::getline(in, line);) {
+    if (line.rfind(field + ":", 0) == 0) return std::atof(line.c_str() + field.size() + 1) / 1024.;
+  }
+  return 0.;
+}
+
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  const G4String physicsListName = (argc > 1) ? argv[1] : PhysicsListFactory::GetDefaultName();
+  const G4int nofThreads = (argc > 2) ? std::atoi(argv[2]) : 1;
+
+  auto start = std::chrono::steady_clock::now();
+  auto runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
+  runManager->SetNumberOfThreads(nofThreads);
+  runManager->SetUserInitialization(new DetectorConstruction());
+  G4VModularPhysicsList* physicsList = PhysicsListFactory::Create(physicsListName);
+  if (!physicsList) {
+    G4cerr << " Unknown physics list " << physicsListName << G4endl;
+    return 1;
+  }
+  physicsList->SetVerboseLevel(0);
+  runManager->SetUserInitialization(physicsList);
+  runManager->SetUserInitialization(new BenchActionInitialization());
+  G4double rssBefore = ReadStatus("VmRSS");
+
+  G4UImanager::GetUIpointer()->ApplyCommand("/control/verbose 0");
+  G4UImanager::GetUIpointer()->ApplyCommand("/run/verbose 0");
+  runManager->Initialize();
+  std::chrono::duration<G4double> initTime = std::chrono::steady_clock::now() - start;
+  G4double rssInit = ReadStatus("VmRSS");
+
+  // physics tables and worker initialisation
+  start = std::chrono::steady_clock::now();
+  runManager->BeamOn(runManager->GetNumberOfThreads());
+  std::chrono::duration<G4double> runTime = std::chrono::steady_clock::now() - start;
+
+  G4cout << G4endl << " Physics list " << physicsListName << ", "
+         << runManager->GetNumberOfThreads() << " thread(s)" << G4endl
+         << "  initialisation : " << initTime.count() << " s" << G4endl
+         << "  first run      : " << runTime.count() << " s" << G4endl
+         << "  RSS            : " << rssBefore << " MB before, " << rssInit
+         << " MB initialised, " << ReadStatus("VmRSS") << " MB after the first run (peak "
+         << ReadStatus("VmHWM") << " MB)" << G4endl;
+
+  delete runManager;
+  return 0;
+}
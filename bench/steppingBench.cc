@@ -0,0 +1,182 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/bench/steppingBench.cc
+/// \brief Micro-benchmark of the stepping action hot path
+///
+/// A stream of synthetic steps is recorded once on the B1 geometry
+/// (points located with a G4Navigator, particle mix dominated by optical
+/// photons) and replayed through:
+///  - the legacy per-step logic (touchable chain + particle name compare),
+///  - the dispatch table of B1::SteppingAction,
+/// both selecting the optical photons in the scoring volume (GdLAB).
+///
+/// Usage: steppingBench [nofSteps] [nofReplays]
+
+#include "DetectorConstruction.hh"
+#include "SteppingAction.hh"
+
+#include "G4DynamicParticle.hh"
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TouchableHistory.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace B1;
+
+namespace
+{
+
+// Baseline SteppingAction::UserSteppingAction, up to the scoring decision
+G4bool LegacyStep(const G4Step* step, const G4LogicalVolume* scoringVolume)
+{
+  G4LogicalVolume* volume =
+    step->GetPreStepPoint()->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
+
+  G4Track* track = step->GetTrack();
+
+  if (track->GetDefinition()->GetParticleName() != "opticalphoton") return false;
+  if (!(volume == scoringVolume)) return false;
+  return true;
+}
+
+// The dispatch table with a handler for the same selection
+class BenchSteppingAction : public SteppingAction
+{
+  public:
+    using SteppingAction::SteppingAction;
+
+    void Build(const DetectorConstruction* detector)
+    {
+      BuildDispatchTable();
+      SetHandler(kOpticalPhoton, detector->GetScoringVolume(),
+                 static_cast<Handler>(&BenchSteppingAction::Select));
+    }
+    std::size_t GetNofSelected() const { return fNofSelected; }
+
+  private:
+    void Select(const G4Step*) { ++fNofSelected; }
+
+    std::size_t fNofSelected = 0;
+};
+
+template<class F>
+G4double TimePerStep(const std::vector<G4Step*>& steps, G4int nofReplays, F&& body)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (G4int r = 0; r < nofReplays; ++r) {
+    for (auto step : steps) body(step);
+  }
+  std::chrono::duration<G4double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / (static_cast<G4double>(steps.size()) * nofReplays);
+}
+
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  const std::size_t nofSteps = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const G4int nofReplays = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+  DetectorConstruction detector;
+  G4VPhysicalVolume* world = detector.Construct();
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world);
+
+  // Record the step stream: 95% optical photons, uniform in the tank
+  G4Random::setTheSeed(12345);
+  const G4ParticleDefinition* particles[] = {G4OpticalPhoton::Definition(),
+                                             G4Electron::Definition(), G4Gamma::Definition()};
+  std::vector<std::unique_ptr<G4Track>> tracks;
+  std::vector<std::unique_ptr<G4Step>> stepStore;
+  std::vector<G4Step*> steps;
+  tracks.reserve(nofSteps);
+  stepStore.reserve(nofSteps);
+  steps.reserve(nofSteps);
+
+  // 1 mm inside the tank, which follows the geometry parameters
+  const G4double rMax = detector.GetTankRadius() - 1. * mm;
+  const G4double zMax = detector.GetTankHalfHeight() - 1. * mm;
+
+  for (std::size_t i = 0; i < nofSteps; ++i) {
+    G4double u = G4UniformRand();
+    const G4ParticleDefinition* particle = particles[(u < 0.95) ? 0 : (u < 0.98) ? 1 : 2];
+
+    G4double r = rMax * std::sqrt(G4UniformRand());
+    G4double phi = twopi * G4UniformRand();
+    G4ThreeVector position(r * std::cos(phi), r * std::sin(phi), (2. * G4UniformRand() - 1.) * zMax);
+
+    navigator.LocateGlobalPointAndSetup(position, nullptr, false, true);
+    G4TouchableHandle touchable(navigator.CreateTouchableHistory());
+
+    auto dynamicParticle =
+      new G4DynamicParticle(particle, G4ThreeVector(0., 0., 1.), (particle == particles[0]) ? 3. * eV : 1. * MeV);
+    auto track = new G4Track(dynamicParticle, 0., position);
+    auto step = new G4Step;
+    step->GetPreStepPoint()->SetTouchableHandle(touchable);
+    step->GetPostStepPoint()->SetTouchableHandle(touchable);
+    step->SetTrack(track);
+    step->SetTotalEnergyDeposit(1. * keV);
+
+    tracks.emplace_back(track);
+    stepStore.emplace_back(step);
+    steps.push_back(step);
+  }
+
+  // Replay
+  const G4LogicalVolume* scoringVolume = detector.GetScoringVolume();
+  std::size_t selected = 0;
+  G4double tLegacy =
+    TimePerStep(steps, nofReplays, [&](const G4Step* step) { selected += LegacyStep(step, scoringVolume); });
+
+  BenchSteppingAction steppingAction;
+  steppingAction.Build(&detector);
+  G4double tDispatch =
+    TimePerStep(steps, nofReplays, [&](const G4Step* step) { steppingAction.UserSteppingAction(step); });
+
+  G4cout << G4endl << " Replayed " << nofSteps << " steps x " << nofReplays << G4endl
+         << "  legacy   : " << tLegacy << " ns/step (" << selected / nofReplays << " selected)" << G4endl
+         << "  dispatch : " << tDispatch << " ns/step ("
+         << steppingAction.GetNofSelected() / nofReplays << " selected)" << G4endl
+         << "  saving   : " << tLegacy - tDispatch << " ns/step" << G4endl;
+
+  return 0;
+}
@@ -28,13 +28,18 @@
 /// \brief Main program of the B1 example
 
 #include "ActionInitialization.hh"
+#include "AsyncOutput.hh"
+#include "CampaignRunner.hh"
 #include "DetectorConstruction.hh"
-#include "QBBC.hh"
+#include "PhotonMapGenerator.hh"
+#include "PhysicsListFactory.hh"
+#include "RunMonitor.hh"
 
 #include "G4RunManagerFactory.hh"
-#include "G4OpticalPhysics.hh"
 #include "G4SteppingVerbose.hh"
+#include "G4VModularPhysicsList.hh"
 #include "G4UIExecutive.hh"
+#include "G4UIcommand.hh"
 #include "G4UImanager.hh"
 #include "G4VisExecutive.hh"
 // #include "Randomize.hh"
@@ -43,12 +48,54 @@ using namespace B1;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+namespace
+{
+void PrintUsage()
+{
+  G4cerr << " Usage: " << G4endl;
+  G4cerr << " exampleB1 [macro] [-t nThreads] [-p physicsList]" << G4endl;
+  G4cerr << "   -t : number of worker threads (multi-threaded and tasking modes)" << G4endl;
+  G4cerr << "   -p : physics list, QBBC (default) or slim; default from the" << G4endl;
+  G4cerr << "        B1_PHYSICS_LIST environment variable if set" << G4endl;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 int main(int argc, char** argv)
 {
-  // Detect interactive mode (if no arguments) and define UI session
+  // Evaluate arguments
+  //
+  G4String macro;
+  G4int nThreads = 0;
+  G4String physicsListName = PhysicsListFactory::GetDefaultName();
+  for (G4int i = 1; i < argc; ++i) {
+    G4String arg = argv[i];
+    if (arg == "-t" || arg == "-p") {
+      if (i + 1 == argc) {
+        PrintUsage();
+        return 1;
+      }
+      if (arg == "-t") {
+        nThreads = G4UIcommand::ConvertToInt(argv[++i]);
+      }
+      else {
+        physicsListName = argv[++i];
+      }
+    }
+    else if (macro.empty() && arg[0] != '-') {
+      macro = arg;
+    }
+    else {
+      PrintUsage();
+      return 1;
+    }
+  }
+
+  // Detect interactive mode (if no macro) and define UI session
   //
   G4UIExecutive* ui = nullptr;
-  if (argc == 1) {
+  if (macro.empty()) {
     ui = new G4UIExecutive(argc, argv);
   }
 
@@ -61,24 +108,45 @@ int main(int argc, char** argv)
 
   // Construct the default run manager
   //
+  // (multi-threaded or tasking if available; the worker threads write
+  //  their own output files, see RunAction)
   auto runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
+  if (nThreads > 0) {
+    runManager->SetNumberOfThreads(nThreads);
+  }
 
   // Set mandatory initialization classes
   //
   // Detector construction
-  runManager->SetUserInitialization(new DetectorConstruction());
-
-  // Physics list
-  auto physicsList = new QBBC;
-  // G4VModularPhysicsList* physicsList = new Shielding;
-  G4OpticalPhysics* opticalPhysics = new G4OpticalPhysics();
-  physicsList->SetVerboseLevel(1);
-  physicsList->RegisterPhysics(opticalPhysics);
+  auto detector = new DetectorConstruction();
+  runManager->SetUserInitialization(detector);
+
+  // Physics list, with the optical physics (see PhysicsListFactory)
+  G4VModularPhysicsList* physicsList = PhysicsListFactory::Create(physicsListName);
+  if (!physicsList) {
+    G4cerr << " Unknown physics list " << physicsListName << G4endl;
+    PrintUsage();
+    delete runManager;
+    delete ui;
+    return 1;
+  }
   runManager->SetUserInitialization(physicsList);
 
   // User action initialization
   runManager->SetUserInitialization(new ActionInitialization());
 
+  // Job-wide services: they live on the master thread and their commands
+  // are not broadcast to the workers
+  //
+  // Photon map generation run mode (/B1/photonMap/)
+  auto photonMapGenerator = new PhotonMapGenerator();
+  // Runs over a table of optical configurations (/B1/campaign/)
+  auto campaignRunner = new CampaignRunner(detector);
+  // Live throughput and progress of the runs (/B1/monitor/)
+  auto runMonitor = new RunMonitor();
+  // Writer threads of the columnar output (/B1/output/async/)
+  auto asyncOutput = new AsyncOutput();
+
   // Initialize visualization with the default graphics system
   auto visManager = new G4VisExecutive(argc, argv);
   // Constructors can also take optional arguments:
@@ -96,8 +164,7 @@ int main(int argc, char** argv)
   if (!ui) {
     // batch mode
     G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    UImanager->ApplyCommand(command + fileName);
+    UImanager->ApplyCommand(command + macro);
   }
   else {
     // interactive mode
@@ -112,6 +179,10 @@ int main(int argc, char** argv)
   // in the main() program !
 
   delete visManager;
+  delete asyncOutput;
+  delete runMonitor;
+  delete campaignRunner;
+  delete photonMapGenerator;
   delete runManager;
 }
 
@@ -0,0 +1,161 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/AsyncOutput.hh
+/// \brief Definition of the B1::AsyncOutput class
+
+#ifndef B1AsyncOutput_h
+#define B1AsyncOutput_h 1
+
+#include "PMTDigi.hh"
+#include "PhotonBuffer.hh"
+#include "RunMonitor.hh"
+#include "SPSCRing.hh"
+
+#include "globals.hh"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class G4GenericMessenger;
+
+namespace B1
+{
+
+class ColumnarOutputWriter;
+
+/// Asynchronous output of the columnar backend (/B1/output/async/).
+///
+/// Each ColumnarOutputWriter gets a channel holding a fixed pool of
+/// records (/B1/output/async/queueSize) and two SPSC rings: the event
+/// thread copies its photons and waveforms into an empty record and
+/// pushes it to the writer threads, which convert the rows to columns,
+/// write the chunks and return the record. When no record is free, the
+/// event thread waits for one: the memory stays bounded and the time
+/// spent waiting, the writer stall, is added to the run monitor counters
+/// of the thread. Close() of the writer waits until its records are
+/// written. At the end of the run, the master prints the number of
+/// records, the stall and flush times and the largest queue depth, which
+/// is used to size the queues.
+///
+/// The ROOT backend is not concerned: G4AnalysisManager is bound to the
+/// Geant4 thread that fills it.
+///
+/// The writer threads are started with the first channel, so their number
+/// and the queue size must be set before the first run.
+
+class AsyncOutput
+{
+  public:
+    // Output of one Fill call of a ColumnarOutputWriter
+    struct Record
+    {
+        G4int eventID = -1;
+        G4bool waveform = false;
+        PhotonBuffer photons;
+        PMTDigi digi{-1, 0};
+    };
+
+    struct Channel
+    {
+        Channel(std::size_t capacity) : full(capacity), empty(capacity) {}
+
+        SPSCRing<Record*> full;  // to the writer thread
+        SPSCRing<Record*> empty;  // back to the event thread
+        std::vector<std::unique_ptr<Record>> records;
+        ColumnarOutputWriter* writer = nullptr;
+        std::atomic<std::uint64_t> nofWritten{0};
+
+        // event thread only
+        std::uint64_t nofPushed = 0;
+        std::uint64_t maxDepth = 0;
+        std::int64_t stallTime = 0;  // ns
+        RunMonitor::ThreadCounters* monitor = nullptr;
+    };
+
+    AsyncOutput();
+    ~AsyncOutput();
+
+    static AsyncOutput* Instance() { return fgInstance; }
+
+    G4bool IsEnabled() const { return fEnabled.load(std::memory_order_acquire); }
+    // New channel of a writer, kept until the end of the job; nullptr if
+    // there are too many
+    Channel* Connect(ColumnarOutputWriter* writer);
+
+    // Event thread: an empty record, waiting for one if none is free
+    static Record& Acquire(Channel& channel);
+    static void Push(Channel& channel, Record& record);
+    // Wait until all the records of the channel are written
+    void Flush(Channel& channel);
+
+    // Print and reset the statistics of the run (master thread)
+    void EndOfRun();
+
+  private:
+    struct Statistics
+    {
+        std::uint64_t nofRecords = 0;
+        std::uint64_t maxDepth = 0;
+        std::int64_t stallTime = 0;  // ns
+        std::int64_t flushTime = 0;  // ns
+    };
+
+    static std::int64_t Now();
+    void Write(G4int index);
+    void DefineCommands();
+    void SetEnabled(G4bool value) { fEnabled.store(value, std::memory_order_release); }
+
+    static inline AsyncOutput* fgInstance = nullptr;
+    static constexpr G4int kMaxChannels = 1024;
+
+    std::atomic<G4bool> fEnabled{false};  // read by the worker threads
+    G4int fNofWriterThreads = 1;
+    G4int fQueueSize = 64;
+
+    std::array<std::atomic<Channel*>, kMaxChannels> fChannels{};
+    std::atomic<G4int> fNofChannels{0};
+    std::vector<std::unique_ptr<Channel>> fOwnedChannels;
+    std::vector<std::thread> fThreads;
+    G4int fNofThreads = 0;  // started
+    std::atomic<G4bool> fStop{false};
+
+    Statistics fStatistics;
+    std::mutex fMutex;  // channels and statistics
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
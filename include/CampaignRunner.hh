@@ -0,0 +1,99 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/CampaignRunner.hh
+/// \brief Definition of the B1::CampaignRunner class
+
+#ifndef B1CampaignRunner_h
+#define B1CampaignRunner_h 1
+
+#include "globals.hh"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+class G4GenericMessenger;
+
+namespace B1
+{
+
+class DetectorConstruction;
+
+/// Campaign of runs over a table of configurations, in one process.
+///
+/// /B1/campaign/run reads the table given with /B1/campaign/file and, for
+/// every configuration, updates the optical property tables in place
+/// (see DetectorConstruction::SetAbsLengthGd() etc.) and the gun energy,
+/// then runs its events. The kernel stays initialised: neither the
+/// geometry nor the physics tables are rebuilt between configurations,
+/// and the events of every run are shared by all the worker threads.
+/// The output of a configuration goes to <fileName>_<id> and a line per
+/// configuration is appended to <fileName>.campaign.
+///
+/// The table is a text file with '#' comments. Its first line names the
+/// columns, each optionally followed by a unit in brackets:
+///   id  absLengthGd[m]  absLengthLAB[m]  reflectivity  qe  yield[1/MeV]
+///   energy[MeV]  events
+/// Every other line is a configuration. Only the columns present are
+/// applied (a parameter keeps its previous value otherwise); without an
+/// id column the configuration number is used, without an events column
+/// /B1/campaign/eventsPerConfig. A range of configurations can be given to
+/// split a campaign over several processes.
+
+class CampaignRunner
+{
+  public:
+    CampaignRunner(DetectorConstruction* detector);
+    ~CampaignRunner();
+
+  private:
+    struct Configuration
+    {
+        G4String id;
+        std::map<G4String, G4double> values;
+    };
+
+    void Run();
+    G4bool ReadTable(std::vector<Configuration>& configurations) const;
+    void Apply(const Configuration& configuration) const;
+    void DefineCommands();
+
+    DetectorConstruction* fDetector = nullptr;
+    G4String fTableFile;
+    G4String fFileName = "Campaign";
+    G4int fEventsPerConfig = 1000;
+    G4int fFirstConfig = 0;
+    G4int fLastConfig = -1;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
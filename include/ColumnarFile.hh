@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/ColumnarFile.hh
+/// \brief Definition of the B1::ColumnarFile class
+
+#ifndef B1ColumnarFile_h
+#define B1ColumnarFile_h 1
+
+#include "ColumnarFormat.hh"
+#include "globals.hh"
+
+#include <sys/types.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace B1
+{
+
+/// Writer of a columnar output file (see ColumnarFormat.hh).
+///
+/// The columns are declared with AddColumn() before Open(). Rows are
+/// added by extending every column with Extend() and then committing them
+/// with CommitRows(); the rows are kept in memory and written as one
+/// chunk when the chunk size is reached, and on Close(), which also
+/// writes the chunk index and trailer. Opening an existing file in append
+/// mode continues it, provided the columns are the same.
+
+class ColumnarFile
+{
+  public:
+    ColumnarFile() = default;
+    ~ColumnarFile();
+
+    ColumnarFile(const ColumnarFile&) = delete;
+    ColumnarFile& operator=(const ColumnarFile&) = delete;
+
+    void AddColumn(const G4String& name, columnar::ColumnType type, G4int count = 1);
+    void ClearColumns();
+
+    G4bool Open(const G4String& fileName, G4bool append = false);
+    void Close();
+    G4bool IsOpen() const { return fFile != nullptr; }
+
+    // Space for nofRows more rows of the given column
+    template <class T>
+    T* Extend(std::size_t column, std::size_t nofRows);
+    void CommitRows(std::size_t nofRows);
+
+    void SetChunkRows(std::size_t nofRows) { fChunkRows = nofRows; }
+    const G4String& GetFileName() const { return fFileName; }
+    std::uint64_t GetNofRows() const { return fNofRows + fPendingRows; }
+
+  private:
+    struct Column
+    {
+        columnar::ColumnDesc desc;
+        std::vector<char> data;
+    };
+
+    G4bool OpenForAppend();
+    void WriteChunk();
+
+    std::vector<Column> fColumns;
+    std::FILE* fFile = nullptr;
+    G4String fFileName;
+    std::vector<columnar::ChunkEntry> fIndex;
+    std::uint64_t fOffset = 0;  // where the next chunk is written
+    std::uint64_t fNofRows = 0;  // rows written to the file
+    std::size_t fPendingRows = 0;  // rows in memory
+    std::size_t fChunkRows = 65536;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <class T>
+T* ColumnarFile::Extend(std::size_t column, std::size_t nofRows)
+{
+  auto& data = fColumns[column].data;
+  std::size_t offset = data.size();
+  data.resize(offset + nofRows * fColumns[column].desc.count * sizeof(T));
+  return reinterpret_cast<T*>(data.data() + offset);
+}
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,153 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/ColumnarFormat.hh
+/// \brief On-disk layout of the B1 columnar output files
+
+#ifndef B1ColumnarFormat_h
+#define B1ColumnarFormat_h 1
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Layout of a columnar file (little-endian, all blocks 8-byte aligned):
+//
+//   FileHeader
+//   ColumnDesc[nofColumns]
+//   chunk 0: column 0 rows, column 1 rows, ... (each padded to 8 bytes)
+//   chunk 1: ...
+//   ChunkEntry[nofChunks]   (chunk index)
+//   Trailer
+//
+// A column holds `count` fixed-width values of its type per row. Appending
+// to a file overwrites the index and trailer with new chunks followed by
+// the extended index and a new trailer. The file is meant to be read with
+// ColumnarReader, which memory-maps it.
+//
+// This header does not depend on Geant4, so that analysis code can use it.
+
+namespace B1::columnar
+{
+
+constexpr char kMagic[8] = {'B', '1', 'C', 'O', 'L', 'U', 'M', 'N'};
+constexpr char kTrailerMagic[8] = {'B', '1', 'C', 'O', 'L', 'E', 'N', 'D'};
+constexpr std::uint32_t kVersion = 1;
+
+enum class ColumnType : std::uint8_t
+{
+  kFloat64 = 1,
+  kFloat32 = 2,
+  kInt32 = 3,
+  kInt64 = 4
+};
+
+inline std::size_t TypeSize(ColumnType type)
+{
+  switch (type) {
+    case ColumnType::kFloat64:
+    case ColumnType::kInt64:
+      return 8;
+    case ColumnType::kFloat32:
+    case ColumnType::kInt32:
+      return 4;
+  }
+  return 0;
+}
+
+template <class T>
+struct TypeOf;
+template <>
+struct TypeOf<double>
+{
+    static constexpr ColumnType value = ColumnType::kFloat64;
+};
+template <>
+struct TypeOf<float>
+{
+    static constexpr ColumnType value = ColumnType::kFloat32;
+};
+template <>
+struct TypeOf<std::int32_t>
+{
+    static constexpr ColumnType value = ColumnType::kInt32;
+};
+template <>
+struct TypeOf<std::int64_t>
+{
+    static constexpr ColumnType value = ColumnType::kInt64;
+};
+
+inline std::uint64_t Align8(std::uint64_t size)
+{
+  return (size + 7) & ~std::uint64_t(7);
+}
+
+struct FileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t nofColumns;
+};
+
+struct ColumnDesc
+{
+    char name[24];
+    std::uint8_t type;
+    std::uint8_t pad[3];
+    std::uint32_t count;  // values per row
+};
+
+struct ChunkEntry
+{
+    std::uint64_t offset;  // from the start of the file
+    std::uint64_t nofRows;
+};
+
+struct Trailer
+{
+    std::uint64_t indexOffset;
+    std::uint64_t nofChunks;
+    std::uint64_t nofRows;
+    char magic[8];
+};
+
+static_assert(sizeof(FileHeader) == 16, "unexpected FileHeader padding");
+static_assert(sizeof(ColumnDesc) == 32, "unexpected ColumnDesc padding");
+static_assert(sizeof(ChunkEntry) == 16, "unexpected ChunkEntry padding");
+static_assert(sizeof(Trailer) == 32, "unexpected Trailer padding");
+
+// Byte size of one column of a chunk, including the padding
+inline std::uint64_t ColumnBytes(const ColumnDesc& column, std::uint64_t nofRows)
+{
+  return Align8(nofRows * column.count * TypeSize(static_cast<ColumnType>(column.type)));
+}
+
+}  // namespace B1::columnar
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
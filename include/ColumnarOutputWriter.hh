@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/ColumnarOutputWriter.hh
+/// \brief Definition of the B1::ColumnarOutputWriter class
+
+#ifndef B1ColumnarOutputWriter_h
+#define B1ColumnarOutputWriter_h 1
+
+#include "AsyncOutput.hh"
+#include "ColumnarFile.hh"
+#include "OutputWriter.hh"
+
+namespace B1
+{
+
+/// Output backend writing flat columnar files that can be memory-mapped
+/// with ColumnarReader.
+///
+/// The photons go to <fileName>.b1col with the columns Energy (eV) and
+/// Time (ns) as doubles, PMT, EventID and TrackID as 32-bit integers.
+/// The waveforms go to <fileName>_waveforms.b1col with the columns
+/// EventID, PMT, Charge and Samples (a fixed number of floats per row).
+/// On worker threads the file names get the _t<N> thread suffix and are
+/// listed in <fileName>.manifest and <fileName>_waveforms.manifest at the
+/// end of the run (see OutputManifest and ColumnarDataset).
+///
+/// With /B1/output/async/enable, the Fill methods only queue a copy of
+/// their data and the rows are written by the AsyncOutput writer threads;
+/// Close() waits until they are done.
+
+class ColumnarOutputWriter : public OutputWriter
+{
+  public:
+    ColumnarOutputWriter();
+    ~ColumnarOutputWriter() override = default;
+
+    void Open(const G4String& fileName, G4bool append) override;
+    void Close() override;
+
+    void FillPhotons(G4int eventID, const PhotonBuffer& photons) override;
+    void FillWaveform(G4int eventID, const PMTDigi& digi) override;
+
+    // Write the rows, from the Fill methods or the writer threads
+    void WritePhotons(G4int eventID, const PhotonBuffer& photons);
+    void WriteWaveform(G4int eventID, const PMTDigi& digi);
+
+  private:
+    enum PhotonColumn
+    {
+      kEnergy,
+      kTime,
+      kPMT,
+      kEventID,
+      kTrackID
+    };
+    enum WaveformColumn
+    {
+      kWaveformEventID,
+      kWaveformPMT,
+      kCharge,
+      kSamples
+    };
+
+    ColumnarFile fPhotons;
+    ColumnarFile fWaveforms;
+    G4String fWaveformsFileName;
+    G4String fManifestBaseName;  // empty if no manifest (sequential mode)
+    G4bool fAppend = false;
+    std::size_t fNofSamples = 0;  // samples per waveform row
+    AsyncOutput::Channel* fChannel = nullptr;  // created at the first asynchronous run
+    G4bool fAsync = false;  // in the current run
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,276 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/ColumnarReader.hh
+/// \brief Definition of the B1::ColumnarReader class
+
+#ifndef B1ColumnarReader_h
+#define B1ColumnarReader_h 1
+
+#include "ColumnarFormat.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace B1
+{
+
+/// Header-only reader of the columnar output files (see ColumnarFormat.hh).
+///
+/// The file is memory-mapped read-only and the columns are returned as
+/// views into the mapping, without copying or decoding:
+///
+///   B1::ColumnarReader reader("PhotonData_t0.b1col");
+///   auto energy = reader.GetColumnIndex("Energy");
+///   double sum = 0.;
+///   reader.ForEach<double>(energy, [&](const double* values, std::size_t n) {
+///     for (std::size_t i = 0; i < n; ++i) sum += values[i];
+///   });
+///
+/// It does not depend on Geant4 and reports errors with std::runtime_error.
+
+class ColumnarReader
+{
+  public:
+    template <class T>
+    struct View
+    {
+        const T* data = nullptr;
+        std::size_t size = 0;  // number of values (rows * count)
+        const T* begin() const { return data; }
+        const T* end() const { return data + size; }
+        const T& operator[](std::size_t i) const { return data[i]; }
+    };
+
+    explicit ColumnarReader(const std::string& fileName)
+    {
+      fFile = ::open(fileName.c_str(), O_RDONLY);
+      if (fFile < 0) throw std::runtime_error("ColumnarReader: cannot open " + fileName);
+      struct stat info;
+      if (::fstat(fFile, &info) != 0) {
+        ::close(fFile);
+        throw std::runtime_error("ColumnarReader: cannot stat " + fileName);
+      }
+      fSize = static_cast<std::size_t>(info.st_size);
+      if (fSize < sizeof(columnar::FileHeader) + sizeof(columnar::Trailer)) {
+        ::close(fFile);
+        throw std::runtime_error("ColumnarReader: file too short: " + fileName);
+      }
+      void* address = ::mmap(nullptr, fSize, PROT_READ, MAP_SHARED, fFile, 0);
+      if (address == MAP_FAILED) {
+        ::close(fFile);
+        throw std::runtime_error("ColumnarReader: cannot map " + fileName);
+      }
+      fBase = static_cast<const char*>(address);
+      ::madvise(address, fSize, MADV_SEQUENTIAL);
+
+      try {
+        Parse();
+      }
+      catch (...) {
+        Release();
+        throw;
+      }
+    }
+
+    ~ColumnarReader() { Release(); }
+
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+
+    std::size_t GetNofColumns() const { return fNofColumns; }
+    std::size_t GetNofChunks() const { return fNofChunks; }
+    std::uint64_t GetNofRows() const { return fTrailer->nofRows; }
+    std::uint64_t GetChunkRows(std::size_t chunk) const { return fIndex[chunk].nofRows; }
+
+    std::string GetColumnName(std::size_t column) const
+    {
+      const char* name = fColumns[column].name;
+      return std::string(name, strnlen(name, sizeof(fColumns[column].name)));
+    }
+    columnar::ColumnType GetColumnType(std::size_t column) const
+    {
+      return static_cast<columnar::ColumnType>(fColumns[column].type);
+    }
+    std::size_t GetColumnCount(std::size_t column) const { return fColumns[column].count; }
+
+    std::size_t GetColumnIndex(const std::string& name) const
+    {
+      for (std::size_t i = 0; i < fNofColumns; ++i) {
+        if (GetColumnName(i) == name) return i;
+      }
+      throw std::runtime_error("ColumnarReader: no column " + name);
+    }
+
+    // View of one column of one chunk
+    template <class T>
+    View<T> Column(std::size_t chunk, std::size_t column) const
+    {
+      if (columnar::TypeOf<T>::value != GetColumnType(column)) {
+        throw std::runtime_error("ColumnarReader: wrong type for column " + GetColumnName(column));
+      }
+      const auto& entry = fIndex[chunk];
+      std::uint64_t offset = entry.offset;
+      for (std::size_t i = 0; i < column; ++i) {
+        offset += columnar::ColumnBytes(fColumns[i], entry.nofRows);
+      }
+      View<T> view;
+      view.data = reinterpret_cast<const T*>(fBase + offset);
+      view.size = static_cast<std::size_t>(entry.nofRows * fColumns[column].count);
+      return view;
+    }
+
+    // Call f(const T* values, std::size_t nofValues) for every chunk
+    template <class T, class F>
+    void ForEach(std::size_t column, F&& f) const
+    {
+      for (std::size_t chunk = 0; chunk < fNofChunks; ++chunk) {
+        auto view = Column<T>(chunk, column);
+        f(view.data, view.size);
+      }
+    }
+
+  private:
+    void Parse()
+    {
+      auto header = reinterpret_cast<const columnar::FileHeader*>(fBase);
+      if (std::memcmp(header->magic, columnar::kMagic, sizeof(columnar::kMagic)) != 0) {
+        throw std::runtime_error("ColumnarReader: not a columnar file");
+      }
+      if (header->version != columnar::kVersion) {
+        throw std::runtime_error("ColumnarReader: unsupported version");
+      }
+      fNofColumns = header->nofColumns;
+      fColumns = reinterpret_cast<const columnar::ColumnDesc*>(fBase + sizeof(*header));
+
+      fTrailer = reinterpret_cast<const columnar::Trailer*>(fBase + fSize - sizeof(columnar::Trailer));
+      if (std::memcmp(fTrailer->magic, columnar::kTrailerMagic, sizeof(columnar::kTrailerMagic))
+          != 0)
+      {
+        throw std::runtime_error("ColumnarReader: missing trailer (file not closed?)");
+      }
+      fNofChunks = static_cast<std::size_t>(fTrailer->nofChunks);
+      if (fTrailer->indexOffset + fNofChunks * sizeof(columnar::ChunkEntry) > fSize) {
+        throw std::runtime_error("ColumnarReader: corrupted chunk index");
+      }
+      fIndex = reinterpret_cast<const columnar::ChunkEntry*>(fBase + fTrailer->indexOffset);
+    }
+
+    void Release()
+    {
+      if (fBase) ::munmap(const_cast<char*>(fBase), fSize);
+      if (fFile >= 0) ::close(fFile);
+      fBase = nullptr;
+      fFile = -1;
+    }
+
+    int fFile = -1;
+    std::size_t fSize = 0;
+    const char* fBase = nullptr;
+    std::size_t fNofColumns = 0;
+    std::size_t fNofChunks = 0;
+    const columnar::ColumnDesc* fColumns = nullptr;
+    const columnar::ChunkEntry* fIndex = nullptr;
+    const columnar::Trailer* fTrailer = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// A set of columnar files read as one: either a single file, or a
+/// manifest written at the end of a multi-threaded run (one file name per
+/// line, relative to the manifest directory). The files are mapped
+/// independently, so they can also be scanned in parallel, one reader
+/// per thread:
+///
+///   B1::ColumnarDataset photons("PhotonData.manifest");
+///   for (std::size_t i = 0; i < photons.GetNofFiles(); ++i) {
+///     const auto& reader = photons.GetReader(i);
+///     ...
+///   }
+
+class ColumnarDataset
+{
+  public:
+    explicit ColumnarDataset(const std::string& fileName)
+    {
+      const std::string suffix = ".manifest";
+      if (fileName.size() < suffix.size()
+          || fileName.compare(fileName.size() - suffix.size(), suffix.size(), suffix) != 0)
+      {
+        fReaders.push_back(std::make_unique<ColumnarReader>(fileName));
+        return;
+      }
+
+      std::ifstream manifest(fileName);
+      if (!manifest) throw std::runtime_error("ColumnarDataset: cannot open " + fileName);
+      auto slash = fileName.find_last_of('/');
+      std::string directory = (slash == std::string::npos) ? "" : fileName.substr(0, slash + 1);
+      std::string line;
+      while (std::getline(manifest, line)) {
+        if (line.empty()) continue;
+        fReaders.push_back(
+          std::make_unique<ColumnarReader>(line[0] == '/' ? line : directory + line));
+      }
+    }
+
+    std::size_t GetNofFiles() const { return fReaders.size(); }
+    const ColumnarReader& GetReader(std::size_t i) const { return *fReaders[i]; }
+
+    std::uint64_t GetNofRows() const
+    {
+      std::uint64_t nofRows = 0;
+      for (const auto& reader : fReaders) nofRows += reader->GetNofRows();
+      return nofRows;
+    }
+
+    // Call f(const T* values, std::size_t nofValues) for every chunk of
+    // every file
+    template <class T, class F>
+    void ForEach(const std::string& column, F&& f) const
+    {
+      for (const auto& reader : fReaders) {
+        reader->ForEach<T>(reader->GetColumnIndex(column), f);
+      }
+    }
+
+  private:
+    std::vector<std::unique_ptr<ColumnarReader>> fReaders;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -5,6 +5,15 @@
 #include "G4VPhysicalVolume.hh"
 #include "G4Material.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4OpticalSurface.hh"
+
+#include "DetectorRegions.hh"
+#include "PMTArrayBuilder.hh"
+
+#include <cstdint>
+#include <memory>
+
+class G4GenericMessenger;
 
 namespace B1 {
 
@@ -15,16 +24,109 @@ public:
     ~DetectorConstruction() override;
 
     G4VPhysicalVolume* Construct() override;
+    void ConstructSDandField() override;
 
     G4LogicalVolume* GetScoringVolume() const { return fScoringVolume; }
 
+    // Inside of the steel tank (construction parameters)
+    G4double GetTankRadius() const { return fTankRadius; }
+    G4double GetTankHalfHeight() const { return fTankHalfHeight; }
+
+    // Gd-LAB target cylinder (valid after Construct)
+    G4double GetTargetRadius() const { return fTargetRadius; }
+    G4double GetTargetHalfLength() const { return fTargetHalfLength; }
+
+    // PMT array (valid after Construct); the layout is symmetric under
+    // rotations by 2 pi / fold about the z axis
+    G4int GetPMTSymmetryFold() const { return fPMTArray->GetSymmetryFold(); }
+    G4int GetNofPMTs() const { return fPMTArray->GetNofPMTs(); }
+
+    // Параметры геометрии; изменение между запусками (Idle) перестраивает
+    // геометрию к следующему /run/beamOn, без пересчёта таблиц физики
+    void SetTankRadius(G4double value)      { SetParameter(fTankRadius, value); }
+    void SetTankThickness(G4double value)   { SetParameter(fTankThickness, value); }
+    void SetTankHalfHeight(G4double value)  { SetParameter(fTankHalfHeight, value); }
+    void SetVesselRadius(G4double value)    { SetParameter(fVesselRadius, value); }
+    void SetVesselThickness(G4double value) { SetParameter(fVesselThickness, value); }
+    void SetVesselHalfHeight(G4double value){ SetParameter(fVesselHalfHeight, value); }
+    void SetPMTRadius(G4double value)       { SetParameter(fPMTRadius, value); }
+    void SetPMTzOffset(G4double value)      { SetParameter(fPMTzOffset, value); }
+    void SetNumPMTperPlane(G4int value);
+    void SetPMTCathodeRadius(G4double value);
+    void SetPMTHalfThickness(G4double value){ SetParameter(fPMTHalfThickness, value); }
+
+    // Оптические параметры: таблицы свойств меняются на месте (форма спектра
+    // сохраняется, задаётся максимум), без перестройки геометрии и физики
+    void SetAbsLengthGd(G4double value);
+    void SetAbsLengthLAB(G4double value);
+    void SetMylarReflectivity(G4double value);
+    void SetPhotocathodeQE(G4double value);
+    void SetScintillationYield(G4double value);
+
 private:
+    // Geometry built from the code, or read from / written to the GDML cache
+    G4VPhysicalVolume* BuildGeometry();
+    // Materials and optical surfaces are created once and reused by the
+    // following constructions (also when read from the GDML cache)
+    void DefineMaterials();
+    static G4OpticalSurface* FindSurface(const G4String& name);
+    // Delete the previous geometry before a new construction
+    void CleanGeometry();
+    static void ClearGeometryStores();
+    void SetParameter(G4double& parameter, G4double value);
+    G4VPhysicalVolume* ReadGeometry() const;
+    void WriteGeometry(const G4VPhysicalVolume* world) const;
+    G4bool ValidateGeometry() const;
+    // Checksum of the construction parameters, stored with the cache
+    std::uint64_t GetChecksum() const;
+
+    void DefineCommands();
+    void SetEmissionFile(G4String fileName);
+    void SetSpectraCacheDirectory(G4String directory);
+
     G4LogicalVolume* fScoringVolume = nullptr;
+    G4LogicalVolume* fPMTVolume = nullptr;
+    G4double fTargetRadius = 0.;
+    G4double fTargetHalfLength = 0.;
+
+    // Стальной бак (внутренний радиус, толщина, полувысота)
+    G4double fTankRadius = 630.*mm;
+    G4double fTankThickness = 2.*mm;
+    G4double fTankHalfHeight = 650.*mm;
+
+    // Сосуд PMMA (внешний радиус, толщина стенок и торцов, полувысота)
+    G4double fVesselRadius = 600.*mm;
+    G4double fVesselThickness = 10.*mm;
+    G4double fVesselHalfHeight = 350.*mm;
+
+    // PMT параметры: радиус колец, плоскости ±fPMTzOffset, размер ФЭУ
+    G4double fPMTRadius = 480.*mm;
+    G4double fPMTzOffset = 400.*mm;
+    G4int    fNumPMTperPlane = 12;
+    G4double fPMTCathodeRadius = 75.*mm;
+    G4double fPMTHalfThickness = 2.*mm;
+    // раскладка ФЭУ (по умолчанию два кольца по fNumPMTperPlane)
+    std::unique_ptr<PMTArrayBuilder> fPMTArray;
+    // регионы Target, Buffer, Shield, PMT с порогами и ограничениями (/B1/region/)
+    std::unique_ptr<DetectorRegions> fRegions;
+
+    // Геометрический кэш и валидация
+    G4String fGDMLCache;
+    G4bool   fValidate = false;
+    G4bool   fCheckOverlaps = false;
+
+    G4bool   fFirstConstruction = true;
+
+    // Материалы (создаются один раз)
+    G4Material* fAir = nullptr;
+    G4Material* fSteel = nullptr;
+    G4Material* fPMMA = nullptr;
+    G4Material* fSilicon = nullptr;
+    G4Material* fLABPure = nullptr;
+    G4Material* fLABGd = nullptr;
 
-    // PMT параметры
-    G4double fPMTRadius = 1.*cm;
-    G4double fPMTzOffset = 5.*cm;
-    G4int    fNumPMTperPlane = 4;
+    std::unique_ptr<G4GenericMessenger> fDetMessenger;
+    std::unique_ptr<G4GenericMessenger> fMessenger;
 };
 
 } // namespace B1
@@ -0,0 +1,112 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/DetectorRegions.hh
+/// \brief Definition of the B1::DetectorRegions class
+
+#ifndef B1DetectorRegions_h
+#define B1DetectorRegions_h 1
+
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
+
+class G4GenericMessenger;
+class G4LogicalVolume;
+class G4ProductionCuts;
+class G4Region;
+class G4UserLimits;
+
+namespace B1
+{
+
+/// Named regions of the detector, each with one root volume:
+///  - Target: the Gd-LAB (also the envelope of the PhotonMapModel),
+///  - Buffer: the LAB buffer, with the PMMA vessel and the PMT envelopes,
+///  - Shield: the steel tank,
+///  - PMT:    the PMTs.
+/// Each region has its own production cut (the default cuts if it is not
+/// set) and user limits on the track time and kinetic energy, applied by
+/// G4UserSpecialCuts to all the particles (G4StepLimiterPhysics, see
+/// PhysicsListFactory); the kinetic energy limit spares the optical
+/// photons. The settings are defined with the /B1/region/ commands,
+/// before or between runs, and kept across the geometry rebuilds.
+
+class DetectorRegions
+{
+  public:
+    DetectorRegions();
+    ~DetectorRegions();
+
+    // Attach the regions to their root volumes, found by name in the
+    // current geometry, and apply the settings
+    void Attach();
+    // Detach the root volumes before the geometry is deleted
+    void Detach();
+
+    // A zero value restores the default cuts / removes the limit
+    void SetCut(const G4String& region, G4double value);
+    void SetMaxTime(const G4String& region, G4double value);
+    void SetMinEkin(const G4String& region, G4double value);
+    void Print() const;
+
+  private:
+    struct Settings
+    {
+        G4String name;
+        G4String rootName;
+        G4double cut = 0.;
+        G4double maxTime = 0.;
+        G4double minEkin = 0.;
+        G4Region* region = nullptr;
+        G4LogicalVolume* root = nullptr;
+        G4ProductionCuts* cuts = nullptr;
+        G4UserLimits* limits = nullptr;
+    };
+
+    Settings* Find(const G4String& name);
+    void Set(const G4String& region, G4double Settings::*value, G4double newValue);
+    void Apply(Settings& settings) const;
+
+    void SetCommand(const G4String& parameters, G4double Settings::*value,
+                    const char* command, const char* defaultUnit);
+    void SetCutCommand(const G4String& parameters);
+    void SetMaxTimeCommand(const G4String& parameters);
+    void SetMinEkinCommand(const G4String& parameters);
+    void ListCommand() { Print(); }
+    void DefineCommands();
+
+    std::vector<Settings> fRegions;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
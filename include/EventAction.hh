@@ -1,10 +1,17 @@
 #ifndef B1EventAction_h
 #define B1EventAction_h 1
 
+#include "PhotonBuffer.hh"
+#include "RunMonitor.hh"
+#include "TriggerEmulator.hh"
+
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
+#include <memory>
+
 class G4Event;
+class G4GenericMessenger;
 
 namespace B1
 {
@@ -12,21 +19,49 @@ namespace B1
 class RunAction;
 
 /// Event action class
+///
+/// The detected photons of the event are appended by PMTSD to a per-thread
+/// PhotonBuffer. In EndOfEventAction(), the PMT waveforms are digitized,
+/// the waveforms and the whole photon buffer are passed to the run action
+/// output (/B1/event/writePhotons false keeps the photons out of the
+/// ntuple and columnar files, not out of the summary) and the
+/// photon energy of the PMT hits is accumulated in the run. The detected
+/// photons also feed the trigger emulation of the run, if active (see
+/// TriggerEmulator).
 
 class EventAction : public G4UserEventAction
 {
   public:
     EventAction(RunAction* runAction);
-    ~EventAction() override = default;
+    ~EventAction() override;
 
     void BeginOfEventAction(const G4Event* event) override;
     void EndOfEventAction(const G4Event* event) override;
 
-    void AddEdep(G4double edep) { fEdep += edep; }
+    void RecordPhoton(G4double energy, G4double time, G4int pmtID, G4int trackID)
+    {
+      fPhotons.Append(energy, time, pmtID, trackID);
+      if (fTrigger) fTrigger->AddPhotoelectron(pmtID, time);
+    }
+
+    // see QECullingValidation
+    void FillCullingValidation(G4double energy, G4double time, G4bool reference, G4bool culled);
+
+    const PhotonBuffer& GetPhotonBuffer() const { return fPhotons; }
 
   private:
+    void DefineCommands();
+
     RunAction* fRunAction = nullptr;
     G4double fEdep = 0.;
+    G4int fPMTHCID = -1;
+    G4int fDigiCollID = -1;
+    PhotonBuffer fPhotons;
+    G4bool fWritePhotons = true;
+    RunMonitor::ThreadCounters* fMonitor = nullptr;
+    TriggerEmulator* fTrigger = nullptr;  // nullptr if not active
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
 };
 
 }  // namespace B1
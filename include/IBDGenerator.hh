@@ -0,0 +1,107 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/IBDGenerator.hh
+/// \brief Definition of the B1::IBDGenerator class
+
+#ifndef B1IBDGenerator_h
+#define B1IBDGenerator_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Event;
+
+namespace B1
+{
+
+/// Generator of reactor-antineutrino inverse beta decays on the free
+/// protons of the target: anti-nu_e + p -> e+ + n.
+///
+/// The antineutrino energy follows the reactor spectrum (Huber-Mueller
+/// fits of the four fissile isotopes, with typical fission fractions)
+/// times the IBD cross section, and the positron angle to the
+/// antineutrino follows dsigma/dcos(theta) at that energy (Vogel-Beacom,
+/// at zeroth order in 1/M). Both are tabulated once per job, when the
+/// shared generator (Instance) is first used: an alias table of the energy bins and, per energy bin, the
+/// inverse CDF of cos(theta) on a uniform grid. Every variable is then
+/// drawn in O(1), without rejection, from a block of four random numbers
+/// per event. The positron energy includes the
+/// first order recoil correction and the neutron takes the momentum
+/// balance.
+
+class IBDGenerator
+{
+  public:
+    IBDGenerator();
+    ~IBDGenerator() = default;
+
+    // The generator of the job, shared read-only by all the threads
+    static const IBDGenerator& Instance();
+
+    // Antineutrino energy, from two uniform random numbers
+    G4double SampleEnergy(G4double u, G4double v) const;
+    // cos(theta) of the positron to the antineutrino for this energy, from
+    // a uniform random number
+    G4double SampleCosTheta(G4double energy, G4double u) const;
+
+    // Positron and neutron of one interaction at the position, the
+    // antineutrino flying along the (unit) direction
+    void GeneratePrimaryVertex(G4Event* event, const G4ThreeVector& position,
+                               const G4ThreeVector& direction) const;
+
+    // Relative reactor flux and IBD cross section, and the angular
+    // distribution (normalised to 1 over cos(theta))
+    static G4double ReactorFlux(G4double energy);
+    static G4double CrossSection(G4double energy);
+    static G4double AngularDistribution(G4double energy, G4double cosTheta);
+
+    static G4double GetThreshold();
+
+  private:
+    void BuildEnergyTable();
+    void BuildAngleTable();
+
+    G4double fEMin = 0.;
+    G4double fEMax = 0.;
+    G4double fBinWidth = 0.;
+    // alias table of the energy bins: bin i is kept with the probability
+    // fProbability[i], else replaced by fAlias[i]
+    std::vector<G4double> fProbability;
+    std::vector<std::size_t> fAlias;
+
+    G4double fAngleBinWidth = 0.;
+    // inverse CDFs of cos(theta), kNofAnglePoints values per energy bin
+    std::vector<G4double> fInverseCDF;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,59 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/NeutronHPPhysics.hh
+/// \brief Definition of the B1::NeutronHPPhysics class
+
+#ifndef B1NeutronHPPhysics_h
+#define B1NeutronHPPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+
+namespace B1
+{
+
+/// High-precision neutron physics below 20 MeV, for the neutron
+/// moderation and capture in the Gd-LAB target: elastic, inelastic and
+/// capture processes with the ParticleHP models and the G4NDL data
+/// ($G4PARTICLEHPDATA). The capture gamma cascades come from the same
+/// data. LAB has no thermal scattering data, so thermal neutrons scatter
+/// as on a free gas. No other hadron has hadronic processes.
+
+class NeutronHPPhysics : public G4VPhysicsConstructor
+{
+  public:
+    NeutronHPPhysics();
+    ~NeutronHPPhysics() override = default;
+
+    void ConstructParticle() override;
+    void ConstructProcess() override;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
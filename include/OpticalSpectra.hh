@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/OpticalSpectra.hh
+/// \brief Definition of the B1::OpticalSpectra class
+
+#ifndef B1OpticalSpectra_h
+#define B1OpticalSpectra_h 1
+
+#include "SpectralTable.hh"
+
+class G4MaterialPropertiesTable;
+
+namespace B1
+{
+
+/// The optical spectra of the detector, built once per process on a
+/// common uniform energy grid.
+///
+/// They are the single source for the material and surface property
+/// tables created in DetectorConstruction and for the quantum
+/// efficiency sampled at run time by PMTSD. The Bi-MSB emission spectrum
+/// is read with SpectralDataLoader from the file set with
+/// SetEmissionFile() (/B1/spectra/emissionFile) before the first
+/// Instance() call.
+
+class OpticalSpectra
+{
+  public:
+    static const OpticalSpectra& Instance();
+
+    // Data files, to be set before the spectra are built
+    static void SetEmissionFile(const G4String& fileName);
+    static void SetCacheDirectory(const G4String& directory);
+    static const G4String& GetEmissionFile() { return fgEmissionFile; }
+
+    // Scale of the QE sampled at run time, changed between runs (see
+    // CampaignRunner); the table itself is not modified
+    static void SetQEScale(G4double scale) { fgQEScale = scale; }
+    static G4double GetQEScale() { return fgQEScale; }
+
+    // Add the table to the MPT under the given key
+    static void AddProperty(G4MaterialPropertiesTable* mpt, const G4String& key,
+                            const SpectralTable& table, G4bool createNewKey = false);
+
+    const std::vector<G4double>& GetEnergies() const { return fQE.GetEnergies(); }
+
+    const SpectralTable& GetRIndexLAB() const { return fRIndexLAB; }
+    const SpectralTable& GetRIndexPMMA() const { return fRIndexPMMA; }
+    const SpectralTable& GetRIndexPMT() const { return fRIndexPMT; }
+    const SpectralTable& GetAbsLengthLABGd() const { return fAbsLengthLABGd; }
+    const SpectralTable& GetAbsLengthLABPure() const { return fAbsLengthLABPure; }
+    const SpectralTable& GetAbsLengthPMMA() const { return fAbsLengthPMMA; }
+    const SpectralTable& GetAbsLengthPMT() const { return fAbsLengthPMT; }
+    const SpectralTable& GetBisMSBEmission() const { return fBisMSBEmission; }
+    const SpectralTable& GetMylarReflectivity() const { return fMylarReflectivity; }
+    const SpectralTable& GetQE() const { return fQE; }
+
+  private:
+    OpticalSpectra();
+
+    static G4bool CheckNotBuilt(const G4String& what);
+
+    static inline G4String fgEmissionFile = "~/bisMSB_EmissionSpectra.dat";
+    static inline G4String fgCacheDirectory;
+    static inline G4bool fgBuilt = false;
+    static inline G4double fgQEScale = 1.;
+
+    SpectralTable fRIndexLAB;
+    SpectralTable fRIndexPMMA;
+    SpectralTable fRIndexPMT;
+    SpectralTable fAbsLengthLABGd;
+    SpectralTable fAbsLengthLABPure;
+    SpectralTable fAbsLengthPMMA;
+    SpectralTable fAbsLengthPMT;
+    SpectralTable fBisMSBEmission;
+    SpectralTable fMylarReflectivity;
+    SpectralTable fQE;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
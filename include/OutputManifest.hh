@@ -0,0 +1,73 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/OutputManifest.hh
+/// \brief Definition of the B1::OutputManifest class
+
+#ifndef B1OutputManifest_h
+#define B1OutputManifest_h 1
+
+#include "G4Threading.hh"
+#include "globals.hh"
+
+#include <map>
+#include <set>
+
+namespace B1
+{
+
+/// Process-wide list of the per-thread output files of the current run.
+///
+/// The output writers of the worker threads add their files when they
+/// open them; at the end of the run the master writes, for each data set,
+/// a manifest file listing them, one file name per line. A manifest can be
+/// passed to ColumnarDataset (columnar files) or used to build a TChain
+/// (ROOT files), so the per-thread files are merged by reference, without
+/// copying the data through the master.
+
+class OutputManifest
+{
+  public:
+    static OutputManifest& Instance();
+
+    // Add a file to the given manifest; thread-safe
+    void Add(const G4String& manifestName, const G4String& fileName);
+    // Write and clear all manifests; called on the master
+    void Write();
+
+  private:
+    OutputManifest() = default;
+    ~OutputManifest() = default;
+
+    G4Mutex fMutex;
+    std::map<G4String, std::set<G4String>> fManifests;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
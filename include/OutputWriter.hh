@@ -0,0 +1,65 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/OutputWriter.hh
+/// \brief Definition of the B1::OutputWriter class
+
+#ifndef B1OutputWriter_h
+#define B1OutputWriter_h 1
+
+#include "globals.hh"
+
+namespace B1
+{
+
+class PhotonBuffer;
+class PMTDigi;
+
+/// Output backend interface
+///
+/// One writer per thread, owned by RunAction and selected with
+/// /B1/output/format. Open() and Close() are called at the beginning and
+/// end of each run, the Fill methods at the end of each event.
+
+class OutputWriter
+{
+  public:
+    OutputWriter() = default;
+    virtual ~OutputWriter() = default;
+
+    // fileName is given without extension
+    virtual void Open(const G4String& fileName, G4bool append) = 0;
+    virtual void Close() = 0;
+
+    virtual void FillPhotons(G4int eventID, const PhotonBuffer& photons) = 0;
+    virtual void FillWaveform(G4int eventID, const PMTDigi& digi) = 0;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,143 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PMTArrayBuilder.hh
+/// \brief Definition of the B1::PMTArrayBuilder class
+
+#ifndef B1PMTArrayBuilder_h
+#define B1PMTArrayBuilder_h 1
+
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
+
+class G4GenericMessenger;
+class G4LogicalVolume;
+class G4Material;
+
+namespace B1
+{
+
+class PMTParameterisation;
+
+/// Builder of PMT arrays made of sections, each a set of rings around the
+/// z axis:
+///  - ring: nofPMTs on a circle in the plane z, facing along z,
+///  - cap:  concentric rings in the plane z, with a given pitch,
+///  - wall: rows of PMTs on a cylinder, facing the axis.
+/// The PMT copy numbers follow the order of the sections and rings, and
+/// the azimuthal order within a ring: ring * nofPMTs + index for rings of
+/// equal size.
+///
+/// Every section is placed in an envelope volume (a disc or a cylindrical
+/// shell of the mother material) holding its PMTs as a single
+/// G4PVParameterised, so that the mother only has a few daughters and the
+/// voxelisation of the envelopes is tuned with /B1/det/pmt/smartless and
+/// /B1/det/pmt/optimise. The envelope copy number is the copy number of
+/// the first PMT of the section: the PMT number is the sum of the copy
+/// numbers of the PMT and its mother. Without envelopes, the PMTs are
+/// placed directly in the mother. Layout or tuning changes made between
+/// runs rebuild the geometry at the next run.
+
+class PMTArrayBuilder
+{
+  public:
+    PMTArrayBuilder();
+    ~PMTArrayBuilder();
+
+    // Layout
+    void AddRing(G4double z, G4double radius, G4int nofPMTs);
+    void AddCap(G4double z, G4double rMax, G4double pitch);
+    void AddWall(G4double radius, G4double zMin, G4double zMax, G4int nofRows, G4int nofPerRow);
+    void Clear();
+    // Two rings at +-zOffset, top first, used as long as no section is added
+    void SetDefaultLayout(G4double zOffset, G4double radius, G4int nofPerRing);
+    // Radius of the PMT discs, to reject caps whose PMTs would overlap
+    void SetPMTRadius(G4double radius) { fPMTRadius = radius; }
+
+    // Navigation tuning
+    void SetUseEnvelopes(G4bool value);
+    void SetSmartless(G4double value);
+    void SetOptimise(G4bool value);
+
+    // Place the PMTs in the mother volume; the envelopes are made of
+    // envelopeMaterial. Returns the number of PMTs.
+    G4int Build(G4LogicalVolume* pmt, G4LogicalVolume* mother, G4Material* envelopeMaterial,
+                G4bool checkOverlaps);
+    // Apply the navigation tuning to the envelopes of the current
+    // geometry, also when it was read from a GDML file
+    void Tune() const;
+
+    G4int GetNofPMTs() const;
+    // Size of the rings if they all have the same number of PMTs (and no
+    // central PMT), else 1: the layout is then symmetric under rotations
+    // by 2 pi / fold, with copy numbers ring * fold + index
+    G4int GetSymmetryFold() const;
+    // Layout parameters, e.g. for a geometry checksum
+    std::vector<G4double> GetParameters() const;
+
+  private:
+    struct Ring
+    {
+        G4double radius;
+        G4double z;
+        G4int nofPMTs;
+    };
+    struct Section
+    {
+        G4bool wall;  // PMTs facing the axis
+        std::vector<Ring> rings;
+    };
+
+    const std::vector<Section>& GetSections() const
+    {
+      return fSections.empty() ? fDefaultSections : fSections;
+    }
+    // Changes between runs rebuild the geometry at the next run
+    void Modified() const;
+
+    void AddRingCommand(const G4String& parameters);
+    void AddCapCommand(const G4String& parameters);
+    void AddWallCommand(const G4String& parameters);
+    void DefineCommands();
+
+    std::vector<Section> fSections;
+    std::vector<Section> fDefaultSections;
+    std::vector<std::unique_ptr<PMTParameterisation>> fParameterisations;
+    G4bool fUseEnvelopes = true;
+    G4double fSmartless = 2.;  // Geant4 default
+    G4bool fOptimise = true;
+    G4double fPMTRadius = 0.;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PMTDigi.hh
+/// \brief Definition of the B1::PMTDigi class
+
+#ifndef B1PMTDigi_h
+#define B1PMTDigi_h 1
+
+#include "G4Allocator.hh"
+#include "G4TDigiCollection.hh"
+#include "G4VDigi.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1
+{
+
+/// PMT digi class
+///
+/// One digi per PMT and event: the waveform sampled by the digitizer,
+/// a fixed number of samples in units of photoelectrons per sample.
+
+class PMTDigi : public G4VDigi
+{
+  public:
+    PMTDigi(G4int pmtID, std::size_t nofSamples);
+    PMTDigi(const PMTDigi&) = default;
+    ~PMTDigi() override = default;
+
+    // operators
+    PMTDigi& operator=(const PMTDigi&) = default;
+    G4bool operator==(const PMTDigi&) const;
+
+    inline void* operator new(size_t);
+    inline void operator delete(void*);
+
+    // methods from base class
+    void Print() override;
+
+    // get methods
+    G4int GetPMTID() const { return fPMTID; }
+    std::vector<G4float>& GetSamples() { return fSamples; }
+    const std::vector<G4float>& GetSamples() const { return fSamples; }
+    G4double GetCharge() const;
+
+  private:
+    G4int fPMTID = -1;
+    std::vector<G4float> fSamples;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+using PMTDigitsCollection = G4TDigiCollection<PMTDigi>;
+
+extern G4ThreadLocal G4Allocator<PMTDigi>* PMTDigiAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* PMTDigi::operator new(size_t)
+{
+  if (!PMTDigiAllocator) PMTDigiAllocator = new G4Allocator<PMTDigi>;
+  return (void*)PMTDigiAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void PMTDigi::operator delete(void* digi)
+{
+  PMTDigiAllocator->FreeSingle((PMTDigi*)digi);
+}
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PMTDigitizer.hh
+/// \brief Definition of the B1::PMTDigitizer class
+
+#ifndef B1PMTDigitizer_h
+#define B1PMTDigitizer_h 1
+
+#include "G4VDigitizerModule.hh"
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
+
+class G4GenericMessenger;
+
+namespace B1
+{
+
+class PhotonBuffer;
+
+/// PMT waveform digitizer
+///
+/// Turns the photoelectrons of the event into one fixed-size waveform per
+/// PMT. The photoelectron times are histogrammed in sampling-period bins
+/// over the acquisition window and convolved with the single-photoelectron
+/// pulse, a normalised difference of exponentials with the given rise and
+/// fall times. Gaussian noise can be added to every sample. The samples are
+/// in units of photoelectrons per sample, so that a waveform sums to its
+/// charge in photoelectrons.
+///
+/// The photoelectrons are read from the EventAction photon buffer, the
+/// number of PMTs from the PMT hits collection. The parameters are set
+/// with the /B1/digi/ commands.
+
+class PMTDigitizer : public G4VDigitizerModule
+{
+  public:
+    PMTDigitizer(const G4String& name, const PhotonBuffer& photons);
+    ~PMTDigitizer() override;
+
+    void Digitize() override;
+
+    G4bool IsEnabled() const { return fEnabled; }
+    std::size_t GetNofSamples() const;
+
+  private:
+    void DefineCommands();
+    void BuildKernel();
+
+    void SetSamplingPeriod(G4double value);
+    void SetWindow(G4double value);
+    void SetRiseTime(G4double value);
+    void SetFallTime(G4double value);
+
+    const PhotonBuffer& fPhotons;
+    G4int fPMTHCID = -1;
+
+    G4bool fEnabled = true;
+    G4double fSamplingPeriod = 2. * CLHEP::ns;
+    G4double fWindow = 512. * CLHEP::ns;
+    G4double fWindowStart = 0.;
+    G4double fRiseTime = 1.5 * CLHEP::ns;
+    G4double fFallTime = 6. * CLHEP::ns;
+    G4double fNoise = 0.;  // sample noise RMS, photoelectrons
+
+    G4bool fKernelValid = false;
+    std::vector<G4float> fKernel;  // SPE pulse per sample, sums to 1
+    std::vector<G4float> fCounts;  // photoelectrons per PMT and sample
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PMTHit.hh
+/// \brief Definition of the B1::PMTHit class
+
+#ifndef B1PMTHit_h
+#define B1PMTHit_h 1
+
+#include "G4Allocator.hh"
+#include "G4THitsCollection.hh"
+#include "G4VHit.hh"
+#include "globals.hh"
+
+namespace B1
+{
+
+/// PMT hit class
+///
+/// One hit per PMT, indexed in the collection by the PMT copy number.
+/// It keeps a per-event summary of the photoelectrons produced on the
+/// photocathode: their number, the earliest arrival time and the energy
+/// sum. The individual photons are kept in the EventAction PhotonBuffer.
+
+class PMTHit : public G4VHit
+{
+  public:
+    PMTHit(G4int pmtID);
+    PMTHit(const PMTHit&) = default;
+    ~PMTHit() override = default;
+
+    // operators
+    PMTHit& operator=(const PMTHit&) = default;
+    G4bool operator==(const PMTHit&) const;
+
+    inline void* operator new(size_t);
+    inline void operator delete(void*);
+
+    // methods from base class
+    void Print() override;
+
+    void AddPhotoelectron(G4double time, G4double energy)
+    {
+      if (fNPhotoelectrons == 0 || time < fFirstTime) fFirstTime = time;
+      ++fNPhotoelectrons;
+      fEnergySum += energy;
+    }
+
+    // get methods
+    G4int GetPMTID() const { return fPMTID; }
+    G4int GetNPhotoelectrons() const { return fNPhotoelectrons; }
+    G4double GetFirstTime() const { return fFirstTime; }
+    G4double GetEnergySum() const { return fEnergySum; }
+
+  private:
+    G4int fPMTID = -1;
+    G4int fNPhotoelectrons = 0;
+    G4double fFirstTime = 0.;
+    G4double fEnergySum = 0.;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+using PMTHitsCollection = G4THitsCollection<PMTHit>;
+
+extern G4ThreadLocal G4Allocator<PMTHit>* PMTHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* PMTHit::operator new(size_t)
+{
+  if (!PMTHitAllocator) PMTHitAllocator = new G4Allocator<PMTHit>;
+  return (void*)PMTHitAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void PMTHit::operator delete(void* hit)
+{
+  PMTHitAllocator->FreeSingle((PMTHit*)hit);
+}
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PMTOccupancy.hh
+/// \brief Definition of the B1::PMTOccupancy class
+
+#ifndef B1PMTOccupancy_h
+#define B1PMTOccupancy_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1
+{
+
+class PhotonBuffer;
+
+/// Per-PMT photoelectron counts and number of events with a photoelectron,
+/// filled by the summary output (see SummaryOutputWriter). The arrays grow
+/// with the largest PMT number seen, so that threads and runs with other
+/// PMT arrays can be merged.
+
+class PMTOccupancy : public G4VAccumulable
+{
+  public:
+    PMTOccupancy();
+    ~PMTOccupancy() override = default;
+
+    // The detected photons of an event
+    void Fill(const PhotonBuffer& photons);
+    // CSV file with the columns pmt, photoelectrons, events, occupancy
+    void Write(const G4String& fileName) const;
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+    void Print(G4PrintOptions options = G4PrintOptions()) const override;
+
+    G4double GetNofEvents() const { return fNofEvents; }
+
+  private:
+    void Resize(std::size_t size);
+
+    G4double fNofEvents = 0.;
+    std::vector<G4double> fPhotoelectrons;
+    std::vector<G4double> fNofHitEvents;
+    // last event with a photoelectron on the PMT, within this thread
+    std::vector<G4double> fLastEvent;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
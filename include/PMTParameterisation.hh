@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PMTParameterisation.hh
+/// \brief Definition of the B1::PMTParameterisation class
+
+#ifndef B1PMTParameterisation_h
+#define B1PMTParameterisation_h 1
+
+#include "G4RotationMatrix.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPVParameterisation.hh"
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
+
+class G4VPhysicalVolume;
+
+namespace B1
+{
+
+/// PMT positions and orientations of one section of a PMTArrayBuilder
+/// layout, in the frame of its envelope volume. Copy i is the i-th PMT
+/// added.
+
+class PMTParameterisation : public G4VPVParameterisation
+{
+  public:
+    PMTParameterisation() = default;
+    ~PMTParameterisation() override = default;
+
+    // Add a PMT; its axis is along z, rotated by the given object rotation
+    void AddPMT(const G4ThreeVector& position, const G4RotationMatrix& rotation);
+
+    void ComputeTransformation(const G4int copyNo, G4VPhysicalVolume* physVol) const override;
+
+    G4int GetNofPMTs() const { return static_cast<G4int>(fPositions.size()); }
+    const G4ThreeVector& GetPosition(G4int copyNo) const { return fPositions[copyNo]; }
+    // frame rotation, as used by the physical volumes (nullptr if none)
+    G4RotationMatrix* GetFrameRotation(G4int copyNo) const { return fFrameRotations[copyNo].get(); }
+
+  private:
+    std::vector<G4ThreeVector> fPositions;
+    std::vector<std::unique_ptr<G4RotationMatrix>> fFrameRotations;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,95 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PMTSD.hh
+/// \brief Definition of the B1::PMTSD class
+
+#ifndef B1PMTSD_h
+#define B1PMTSD_h 1
+
+#include "PMTHit.hh"
+#include "RandomBlock.hh"
+#include "RunMonitor.hh"
+
+#include "G4VSensitiveDetector.hh"
+
+class G4Step;
+class G4HCofThisEvent;
+
+namespace B1
+{
+
+class EventAction;
+class PhotonInformation;
+class SpectralTable;
+
+/// PMT sensitive detector class
+///
+/// The detector is attached to the PMT logical volume. It is invoked by
+/// G4OpBoundaryProcess when an optical photon is absorbed on the
+/// photocathode surface (Detection status, see /process/optical/boundary/
+/// setInvokeSD), samples the quantum efficiency if StackingAction has not
+/// done it at the photon birth, updates the hit of the PMT
+/// with the touched copy number and appends the photoelectron to the
+/// EventAction photon buffer.
+
+class PMTSD : public G4VSensitiveDetector
+{
+  public:
+    PMTSD(const G4String& name, const G4String& hitsCollectionName, G4int nofPMTs);
+    ~PMTSD() override = default;
+
+    // methods from base class
+    void Initialize(G4HCofThisEvent* hitCollection) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+    void EndOfEvent(G4HCofThisEvent* hitCollection) override;
+
+    // Number of PMTs, updated when the geometry is rebuilt
+    void SetNofPMTs(G4int nofPMTs) { fNofPMTs = nofPMTs; }
+    G4int GetNofPMTs() const { return fNofPMTs; }
+
+    // Sample the QE, unless it was sampled at birth (see StackingAction),
+    // and record a photon reaching the photocathode of the given PMT; also
+    // used by the parametrised optical model
+    G4bool RecordPhoton(G4int pmtID, G4double time, G4double energy, G4int trackID,
+                        const PhotonInformation* info = nullptr);
+
+  private:
+    PMTHitsCollection* fHitsCollection = nullptr;
+    G4int fNofPMTs = 0;
+    EventAction* fEventAction = nullptr;
+    const SpectralTable* fQE = nullptr;  // photocathode quantum efficiency
+    G4double fQEScale = 1.;
+    G4bool fApplyQE = true;
+    RandomBlock fRandoms;
+    RunMonitor::ThreadCounters* fMonitor = nullptr;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
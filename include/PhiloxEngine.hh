@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhiloxEngine.hh
+/// \brief Definition of the B1::PhiloxEngine class
+
+#ifndef B1PhiloxEngine_h
+#define B1PhiloxEngine_h 1
+
+#include "Randomize.hh"
+
+#include <array>
+#include <cstdint>
+
+namespace B1
+{
+
+/// Counter-based random engine: Philox4x32-10 (Salmon et al., SC'11).
+///
+/// The random numbers are a keyed bijection of a counter: block n of a
+/// stream is Philox(key, (n, stream)), four 32-bit words, i.e. two
+/// doubles of 53 bits. The engine has no other state, so that a stream
+/// can be positioned anywhere without generating the numbers before it.
+/// With the key set to the run seed and the stream to the event number
+/// (SetStream), every event has its own sequence, independent of the
+/// thread that processes it and of the events processed before.
+
+class PhiloxEngine : public CLHEP::HepRandomEngine
+{
+  public:
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    // The Philox4x32-10 bijection of one counter
+    static Counter Generate(Counter counter, Key key);
+
+    explicit PhiloxEngine(std::uint64_t seed = 0);
+    ~PhiloxEngine() override = default;
+
+    // Start the stream of the (seed, stream) pair at its first number
+    void SetStream(std::uint64_t seed, std::uint64_t stream);
+
+    double flat() override { return Next(); }
+    void flatArray(const int size, double* vect) override;
+
+    // The seeds set the key and restart the current stream; the per-event
+    // seeds of the Geant4 worker threads are overridden by SetStream
+    void setSeed(long seed, int) override;
+    void setSeeds(const long* seeds, int) override;
+    void saveStatus(const char filename[] = "Config.conf") const override;
+    void restoreStatus(const char filename[] = "Config.conf") override;
+    void showStatus() const override;
+    std::string name() const override { return "PhiloxEngine"; }
+
+    std::ostream& put(std::ostream& os) const override;
+    std::istream& get(std::istream& is) override;
+    std::istream& getState(std::istream& is) override;
+
+  private:
+    inline double Next();
+    void NextBlock();
+
+    Key fKey = {0, 0};
+    std::uint64_t fStream = 0;
+    std::uint64_t fBlock = 0;  // index of the next block
+    Counter fOutput = {0, 0, 0, 0};
+    unsigned int fNext = 4;  // next word of fOutput, 4 if none left
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline double PhiloxEngine::Next()
+{
+  if (fNext == 4) NextBlock();
+  const std::uint64_t bits = (std::uint64_t(fOutput[fNext]) << 32) | fOutput[fNext + 1];
+  fNext += 2;
+  // 53 bits, in the open interval (0, 1)
+  return ((bits >> 11) + 0.5) * 0x1.0p-53;
+}
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhotonBuffer.hh
+/// \brief Definition of the B1::PhotonBuffer class
+
+#ifndef B1PhotonBuffer_h
+#define B1PhotonBuffer_h 1
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace B1
+{
+
+/// Per-event buffer of detected photons, stored as a structure of arrays
+/// (energy, time, PMT id, track id).
+///
+/// The buffer is cleared, not freed, between events. Reserve() sizes it
+/// from a running average of the previous events, so that Append() does
+/// not allocate in the stepping loop.
+
+class PhotonBuffer
+{
+  public:
+    PhotonBuffer() = default;
+    ~PhotonBuffer() = default;
+
+    void Append(G4double energy, G4double time, G4int pmtID, G4int trackID)
+    {
+      fEnergies.push_back(energy);
+      fTimes.push_back(time);
+      fPMTIDs.push_back(pmtID);
+      fTrackIDs.push_back(trackID);
+    }
+
+    // Reserve for the expected photon count (running average plus margin)
+    void Reserve()
+    {
+      auto expected = static_cast<std::size_t>(std::ceil(fMeanSize * 1.25)) + 16;
+      if (fEnergies.capacity() >= expected) return;
+      fEnergies.reserve(expected);
+      fTimes.reserve(expected);
+      fPMTIDs.reserve(expected);
+      fTrackIDs.reserve(expected);
+    }
+
+    // Update the running average with the current size and clear
+    void Clear()
+    {
+      // cumulative mean over the first events, then an exponential
+      // average weighting the last ~10 events
+      ++fNofEvents;
+      G4double weight = std::max(1. / fNofEvents, 0.1);
+      fMeanSize += weight * (static_cast<G4double>(fEnergies.size()) - fMeanSize);
+      fEnergies.clear();
+      fTimes.clear();
+      fPMTIDs.clear();
+      fTrackIDs.clear();
+    }
+
+    std::size_t Size() const { return fEnergies.size(); }
+    G4bool Empty() const { return fEnergies.empty(); }
+    G4double GetMeanSize() const { return fMeanSize; }
+
+    const std::vector<G4double>& GetEnergies() const { return fEnergies; }
+    const std::vector<G4double>& GetTimes() const { return fTimes; }
+    const std::vector<G4int>& GetPMTIDs() const { return fPMTIDs; }
+    const std::vector<G4int>& GetTrackIDs() const { return fTrackIDs; }
+
+  private:
+    std::vector<G4double> fEnergies;
+    std::vector<G4double> fTimes;
+    std::vector<G4int> fPMTIDs;
+    std::vector<G4int> fTrackIDs;
+    G4double fMeanSize = 0.;
+    G4int fNofEvents = 0;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
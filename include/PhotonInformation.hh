@@ -0,0 +1,73 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhotonInformation.hh
+/// \brief Definition of the B1::PhotonInformation class
+
+#ifndef B1PhotonInformation_h
+#define B1PhotonInformation_h 1
+
+#include "G4VUserTrackInformation.hh"
+#include "globals.hh"
+
+namespace B1
+{
+
+/// Track information attached by StackingAction to the optical photons
+/// for which the photocathode QE was sampled at birth, so that PMTSD
+/// does not sample it again.
+///
+/// Only accepted photons are tracked, except in the validation mode of
+/// the stacking action, where all photons are tracked and carry the
+/// decision taken at birth.
+
+class PhotonInformation : public G4VUserTrackInformation
+{
+  public:
+    PhotonInformation(G4bool accepted, G4bool validation, G4double timeWindow)
+      : G4VUserTrackInformation("PhotonInformation"), fAccepted(accepted),
+        fValidation(validation), fTimeWindow(timeWindow)
+    {}
+    ~PhotonInformation() override = default;
+
+    // Photon accepted at birth (QE and time window)
+    G4bool IsAccepted() const { return fAccepted; }
+    // Photon tracked only to validate the decision taken at birth
+    G4bool IsValidation() const { return fValidation; }
+    // Detection time window applied at birth (none if 0)
+    G4double GetTimeWindow() const { return fTimeWindow; }
+
+  private:
+    G4bool fAccepted = true;
+    G4bool fValidation = false;
+    G4double fTimeWindow = 0.;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
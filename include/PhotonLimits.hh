@@ -0,0 +1,104 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhotonLimits.hh
+/// \brief Definition of the B1::PhotonLimits class
+
+#ifndef B1PhotonLimits_h
+#define B1PhotonLimits_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <array>
+#include <memory>
+
+class G4GenericMessenger;
+class G4OpBoundaryProcess;
+class G4Step;
+
+namespace B1
+{
+
+/// Limits on the global time, number of reflections and path length of
+/// the optical photons (/B1/photonLimits/), which cut the long tail of
+/// photons bouncing in the tank after any trigger window has closed.
+///
+/// The stepping action calls Check() after each step of an optical photon
+/// while a limit is set. The reflections are counted from the status of
+/// G4OpBoundaryProcess on the steps ending at a volume boundary; a photon
+/// over a limit is killed after that step. The number of photons killed
+/// per limit is merged over the threads and printed at the end of the run.
+
+class PhotonLimits : public G4VAccumulable
+{
+  public:
+    PhotonLimits();
+    ~PhotonLimits() override;
+
+    // Activation for the run, if a limit is set
+    void BeginOfRun();
+    G4bool IsActive() const { return fActive; }
+
+    // Count the reflections of an optical photon and kill it over a limit
+    void Check(const G4Step* step);
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+    void Print(G4PrintOptions options = G4PrintOptions()) const override;
+
+  private:
+    enum Reason
+    {
+      kTime = 0,
+      kReflections,
+      kLength,
+      kNofReasons
+    };
+
+    void DefineCommands();
+
+    // limits, 0 = none
+    G4double fMaxTime = 0.;
+    G4int fMaxReflections = 0;
+    G4double fMaxLength = 0.;
+
+    G4bool fActive = false;
+    const G4OpBoundaryProcess* fBoundary = nullptr;
+    G4int fNofReflections = 0;  // of the current photon
+
+    G4double fNofPhotons = 0.;
+    std::array<G4double, kNofReasons> fNofKilled = {};
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,142 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhotonMap.hh
+/// \brief Definition of the B1::PhotonMap class
+
+#ifndef B1PhotonMap_h
+#define B1PhotonMap_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace B1
+{
+
+/// Per-PMT detection probability and time-of-flight map of optical
+/// photons emitted in the target cylinder.
+///
+/// The map is tabulated on an (r, phi, z) grid covering one phi sector of
+/// the detector, which has an nFold rotational symmetry: the PMTs are
+/// arranged in rings of nFold PMTs, with copy number ring * nFold + index.
+/// A photon in sector k is mapped to sector 0 and the sampled PMT index is
+/// rotated back by k. For every cell and PMT, the map holds the detection
+/// probability (before the photocathode QE, which is applied by PMTSD) and
+/// the cumulative distribution of the time of flight.
+///
+/// Binary format, version 1 (little-endian):
+///   Header
+///   uint64  launched photons     [nofCells]
+///   float   detection probability [nofCells][nofPMTs]
+///   float   time-of-flight CDF    [nofCells][nofPMTs][nofTimeBins]
+
+class PhotonMap
+{
+  public:
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t nofR;
+        std::uint32_t nofPhi;
+        std::uint32_t nofZ;
+        std::uint32_t nofFold;
+        std::uint32_t nofPMTs;
+        std::uint32_t nofTimeBins;
+        std::uint32_t reserved;
+        double rMax;
+        double zMin;
+        double zMax;
+        double tMax;
+    };
+
+    PhotonMap() = default;
+    PhotonMap(G4int nofR, G4int nofPhi, G4int nofZ, G4int nofFold, G4int nofPMTs,
+              G4int nofTimeBins, G4double rMax, G4double zMin, G4double zMax, G4double tMax);
+    ~PhotonMap() = default;
+
+    // Read-only map shared by all threads, loaded once per file name
+    static std::shared_ptr<const PhotonMap> Load(const G4String& fileName);
+
+    G4bool Read(const G4String& fileName);
+    G4bool Write(const G4String& fileName) const;
+
+    // Cell and sector of a position in the target frame; -1 if outside
+    G4int GetCell(const G4ThreeVector& position, G4int& sector) const;
+    // Centre of a cell of sector 0 and its (r, phi, z) bin indices
+    G4ThreeVector GetCellCentre(G4int cell) const;
+    void GetCellBins(G4int cell, G4int& iR, G4int& iPhi, G4int& iZ) const;
+
+    // Sampling, with u uniform in [0, 1): the detected PMT of sector 0
+    // (-1 if the photon is not detected) and its time of flight
+    G4int SamplePMT(G4int cell, G4double u) const;
+    G4double SampleTime(G4int cell, G4int pmt, G4double u) const;
+    // PMT copy number of a sector-0 PMT seen from the given sector
+    G4int RotatePMT(G4int pmt, G4int sector) const;
+
+    // Fill a cell from nofLaunched photons, the detected counts per PMT
+    // and their time-of-flight histograms [nofPMTs][nofTimeBins]
+    void SetCell(G4int cell, std::uint64_t nofLaunched, const G4double* detected,
+                 const G4double* tofHistograms);
+    // Copy all cells of a map with the same (r, phi) grid, PMTs and time
+    // bins, e.g. a z-slice, starting at the given cell
+    void CopyCells(const PhotonMap& source, G4int firstCell);
+
+    G4int GetNofR() const { return fHeader.nofR; }
+    G4int GetNofPhi() const { return fHeader.nofPhi; }
+    G4int GetNofZ() const { return fHeader.nofZ; }
+    G4int GetNofCells() const { return static_cast<G4int>(fLaunched.size()); }
+    G4int GetNofPMTs() const { return fHeader.nofPMTs; }
+    G4int GetNofFold() const { return fHeader.nofFold; }
+    G4int GetNofTimeBins() const { return fHeader.nofTimeBins; }
+    G4double GetTimeMax() const { return fHeader.tMax; }
+    std::uint64_t GetLaunched(G4int cell) const { return fLaunched[cell]; }
+    G4double GetProbability(G4int cell, G4int pmt) const
+    {
+      return fProbabilities[cell * fHeader.nofPMTs + pmt];
+    }
+
+  private:
+    void BuildCumulative();
+    void BuildCumulative(G4int cell);
+
+    Header fHeader = {};
+    G4double fSector = 0.;  // sector width in phi
+    std::vector<std::uint64_t> fLaunched;
+    std::vector<G4float> fProbabilities;
+    std::vector<G4float> fTimeCDFs;
+    std::vector<G4float> fCumulative;  // running sum of the probabilities per cell
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
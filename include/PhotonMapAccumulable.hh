@@ -0,0 +1,86 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhotonMapAccumulable.hh
+/// \brief Definition of the B1::PhotonMapAccumulable class
+
+#ifndef B1PhotonMapAccumulable_h
+#define B1PhotonMapAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1
+{
+
+class PhotonBuffer;
+
+/// Photon counts of the grid slice processed in a photon map generation
+/// run (see PhotonMapGenerator): per cell, the number of launched photons
+/// and, per PMT, the number of detected photons and their time-of-flight
+/// histogram. The worker accumulables are merged into the master one at
+/// the end of the run.
+
+class PhotonMapAccumulable : public G4VAccumulable
+{
+  public:
+    PhotonMapAccumulable();
+    ~PhotonMapAccumulable() override = default;
+
+    // Add the photons detected in an event that launched nofLaunched
+    // photons from the given cell of the slice
+    void Fill(G4int cell, G4int nofLaunched, const PhotonBuffer& photons);
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+    void Print(G4PrintOptions options = G4PrintOptions()) const override;
+
+    G4int GetNofCells() const { return static_cast<G4int>(fLaunched.size()); }
+    G4double GetLaunched(G4int cell) const { return fLaunched[cell]; }
+    // [nofPMTs] and [nofPMTs][nofTimeBins] arrays of a cell
+    const G4double* GetDetected(G4int cell) const { return &fDetected[cell * fNofPMTs]; }
+    const G4double* GetTimeHistograms(G4int cell) const
+    {
+      return &fTimeHistograms[cell * fNofPMTs * fNofTimeBins];
+    }
+
+  private:
+    G4int fNofPMTs = 0;
+    G4int fNofTimeBins = 0;
+    G4double fInvTimeBinWidth = 0.;
+    std::vector<G4double> fLaunched;
+    std::vector<G4double> fDetected;
+    std::vector<G4double> fTimeHistograms;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhotonMapGenerator.hh
+/// \brief Definition of the B1::PhotonMapGenerator class
+
+#ifndef B1PhotonMapGenerator_h
+#define B1PhotonMapGenerator_h 1
+
+#include "globals.hh"
+
+#include <atomic>
+#include <memory>
+
+class G4Event;
+class G4GenericMessenger;
+
+namespace B1
+{
+
+class PhotonMapAccumulable;
+
+/// Photon map generation run mode.
+///
+/// /B1/photonMap/generate builds a PhotonMap of the current geometry with
+/// full optical tracking. The (r, phi, z) grid covers the GdLAB target
+/// cylinder over one phi sector of the PMT ring (the map has the nFold
+/// symmetry of the PMT planes). The z-slices of the grid are generated
+/// one run per slice: every event launches mono-energetic, isotropic
+/// optical photons from random points of a single cell, so the events
+/// (and the cells) of a slice are shared among the worker threads. The
+/// detected photons, before the photocathode QE, are counted per cell and
+/// PMT in a PhotonMapAccumulable and the master writes every finished
+/// slice to <fileName>.slice<k>.
+///
+/// Slices with an existing file are skipped, so an interrupted generation
+/// is resumed by repeating the command, and a range of slices can be
+/// given to distribute the map over several processes. When all slices
+/// are present they are assembled into <fileName>.
+///
+/// The worker threads only read the generator settings during a run.
+
+class PhotonMapGenerator
+{
+  public:
+    PhotonMapGenerator();
+    ~PhotonMapGenerator();
+
+    static PhotonMapGenerator* Instance() { return fgInstance; }
+    // True during the runs of a map generation
+    static G4bool IsActive() { return fgActive.load(std::memory_order_acquire); }
+
+    // Photons of an event of the current slice (worker threads)
+    void GeneratePrimaries(G4Event* event) const;
+    // Cell of the slice of an event
+    G4int GetSliceCell(G4int eventID) const { return eventID / fEventsPerCell; }
+    G4int GetNofSliceCells() const { return fNofR * fNofPhi; }
+    G4int GetPhotonsPerEvent() const { return fPhotonsPerEvent; }
+    G4int GetNofPMTs() const { return fNofPMTs; }
+    G4int GetNofTimeBins() const { return fNofTimeBins; }
+    G4double GetTimeMax() const { return fTimeMax; }
+
+    // Write the merged counts of the current slice (master thread)
+    void EndOfSlice(const PhotonMapAccumulable& accumulable);
+
+  private:
+    void Generate();
+    void Assemble();
+    // Target cylinder and PMT ring of the current geometry
+    void UpdateGeometry();
+    G4bool IsSliceDone(G4int slice) const;
+    G4String GetSliceFileName(G4int slice) const;
+    void DefineCommands();
+
+    static inline PhotonMapGenerator* fgInstance = nullptr;
+    // read by the worker threads while the master sets it
+    static inline std::atomic<G4bool> fgActive{false};
+
+    // grid and sampling
+    G4int fNofR = 10;
+    G4int fNofPhi = 4;
+    G4int fNofZ = 14;
+    G4int fNofTimeBins = 100;
+    G4double fTimeMax = 0.;
+    G4double fEnergy = 0.;
+    G4int fPhotonsPerEvent = 1000;
+    G4int fEventsPerCell = 10;
+    G4String fFileName = "PhotonMap.bin";
+    G4int fFirstSlice = 0;
+    G4int fLastSlice = -1;
+
+    // taken from the detector construction at the start of the generation
+    G4double fRMax = 0.;
+    G4double fZMin = 0.;
+    G4double fZMax = 0.;
+    G4int fNofFold = 1;
+    G4int fNofPMTs = 0;
+    G4int fSlice = 0;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
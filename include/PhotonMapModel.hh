@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhotonMapModel.hh
+/// \brief Definition of the B1::PhotonMapModel class
+
+#ifndef B1PhotonMapModel_h
+#define B1PhotonMapModel_h 1
+
+#include "G4VFastSimulationModel.hh"
+
+#include <memory>
+
+class G4GenericMessenger;
+
+namespace B1
+{
+
+class PhotonMap;
+class PMTSD;
+
+/// Parametrised optical model for the target region.
+///
+/// Every optical photon created in the target (GdLAB) is killed at its
+/// first step. Its detecting PMT and time of flight are sampled from the
+/// photon map of its emission point instead, and the photon is handed to
+/// PMTSD, which applies the photocathode QE as for tracked photons. Photons
+/// entering the target from outside are tracked as usual.
+///
+/// The model is active once a map is loaded with /B1/fastsim/mapFile and
+/// can be switched off with /B1/fastsim/enable false, to compare with the
+/// full optical tracking. A map made for another number of PMTs than the
+/// current geometry is rejected.
+
+class PhotonMapModel : public G4VFastSimulationModel
+{
+  public:
+    PhotonMapModel(const G4String& name, G4Region* envelope, PMTSD* pmtSD);
+    ~PhotonMapModel() override;
+
+    G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+    G4bool ModelTrigger(const G4FastTrack& fastTrack) override;
+    void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) override;
+
+  private:
+    void DefineCommands();
+    void LoadMap(const G4String& fileName);
+
+    PMTSD* fPMTSD = nullptr;
+    std::shared_ptr<const PhotonMap> fMap;
+    G4bool fEnabled = true;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
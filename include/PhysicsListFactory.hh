@@ -0,0 +1,63 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/PhysicsListFactory.hh
+/// \brief Definition of the B1::PhysicsListFactory class
+
+#ifndef B1PhysicsListFactory_h
+#define B1PhysicsListFactory_h 1
+
+#include "globals.hh"
+
+class G4VModularPhysicsList;
+
+namespace B1
+{
+
+/// Physics lists of the application, with the optical physics and the
+/// fast simulation of the optical photons (PhotonMapModel) added:
+///  - QBBC : the reference list (default),
+///  - slim : SlimPhysicsList, for MeV-scale leptons, gammas and
+///           neutrons below 20 MeV.
+/// The list is selected with the -p option of exampleB1 or with the
+/// B1_PHYSICS_LIST environment variable.
+
+class PhysicsListFactory
+{
+  public:
+    PhysicsListFactory() = delete;
+
+    // Name from the environment, else the default
+    static G4String GetDefaultName();
+    // nullptr if the name is unknown
+    static G4VModularPhysicsList* Create(const G4String& name);
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
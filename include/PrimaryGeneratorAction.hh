@@ -30,19 +30,42 @@
 #ifndef B1PrimaryGeneratorAction_h
 #define B1PrimaryGeneratorAction_h 1
 
+#include "G4ThreeVector.hh"
 #include "G4VUserPrimaryGeneratorAction.hh"
 
+#include <atomic>
+#include <memory>
+
 class G4ParticleGun;
 class G4Event;
 class G4Box;
+class G4GenericMessenger;
+namespace CLHEP
+{
+class HepRandomEngine;
+}
 
 namespace B1
 {
 
+class PhiloxEngine;
+
 /// The primary generator action class with particle gun.
 ///
-/// The default kinematic is a 6 MeV gamma, randomly distribued
-/// in front of the phantom across 80% of the (X,Y) phantom size.
+/// The primary vertex is uniformly distributed in the Gd-LAB target.
+/// Two modes are selected with /B1/gun/mode:
+///  - gun: the particle gun (/gun/ commands; by default a 3 MeV e+),
+///    isotropic,
+///  - ibd: a reactor-antineutrino inverse beta decay, e+ and neutron
+///    (see IBDGenerator), the antineutrinos flying along /B1/gun/ibdDirection.
+///
+/// With /B1/random/counterBased, the random engine of the thread is a
+/// PhiloxEngine set, before the primaries of every event are generated,
+/// to the stream /B1/random/firstEvent + event ID of the key (seed, run):
+/// /B1/random/seed and the run ID, or /B1/random/runNumber to replay an
+/// earlier run. An event is reproduced whatever the number of threads,
+/// the runs of a job have different events, and a run can be split into
+/// jobs of consecutive events, or reduced to one event, with firstEvent.
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -55,10 +78,36 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 
     // method to access particle gun
     const G4ParticleGun* GetParticleGun() const { return fParticleGun; }
+    G4bool IsIBDMode() const { return fMode == "ibd"; }
+
+    // ID of the current run, set by the master before the events start
+    static void SetRunID(G4int runID) { fgRunID.store(runID, std::memory_order_release); }
 
   private:
+    // Position from three uniform random numbers
+    G4ThreeVector SampleVertex(const G4double* u) const;
+    void SetEventStream(const G4Event* event);
+    void SetMode(const G4String& mode);
+    void SetNeutrinoDirection(G4ThreeVector direction);
+    void DefineCommands();
+
     G4ParticleGun* fParticleGun = nullptr;  // pointer a to G4 gun class
     G4Box* fEnvelopeBox = nullptr;
+
+    G4String fMode = "gun";
+    G4ThreeVector fNeutrinoDirection = G4ThreeVector(1., 0., 0.);
+
+    // per-event random streams
+    G4bool fCounterBased = false;
+    G4int fSeed = 12345;
+    G4int fFirstEvent = 0;
+    G4int fRunNumber = -1;  // run in the key, -1 for the run ID
+    static inline std::atomic<G4int> fgRunID{0};
+    std::unique_ptr<PhiloxEngine> fEngine;
+    CLHEP::HepRandomEngine* fDefaultEngine = nullptr;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+    std::unique_ptr<G4GenericMessenger> fRandomMessenger;
 };
 
 }  // namespace B1
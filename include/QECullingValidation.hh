@@ -0,0 +1,82 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/QECullingValidation.hh
+/// \brief Definition of the B1::QECullingValidation class
+
+#ifndef B1QECullingValidation_h
+#define B1QECullingValidation_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <array>
+
+namespace B1
+{
+
+/// Validation of the culling of the optical photons at birth (see
+/// StackingAction): energy and time spectra of the photons detected with
+/// the QE sampled at the photocathode (reference) and at birth (culled).
+/// Both are samples of the same distribution; Print() reports the
+/// chi2 test of their compatibility.
+
+class QECullingValidation : public G4VAccumulable
+{
+  public:
+    QECullingValidation();
+    ~QECullingValidation() override = default;
+
+    // A photon reaching a photocathode, detected in the reference and/or
+    // the culled sample
+    void Fill(G4double energy, G4double time, G4bool reference, G4bool culled);
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+    void Print(G4PrintOptions options = G4PrintOptions()) const override;
+
+    G4double GetNofEntries() const;
+
+  private:
+    static constexpr G4int kNofBins = 40;
+    using Histogram = std::array<G4double, kNofBins>;
+
+    // chi2 of two histograms with different totals, and its number of
+    // degrees of freedom
+    static G4double Chi2(const Histogram& h1, const Histogram& h2, G4int& ndf);
+
+    Histogram fEnergyReference = {};
+    Histogram fEnergyCulled = {};
+    Histogram fTimeReference = {};
+    Histogram fTimeCulled = {};
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/RandomBlock.hh
+/// \brief Definition of the B1::RandomBlock class
+
+#ifndef B1RandomBlock_h
+#define B1RandomBlock_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1
+{
+
+/// Block of uniform random numbers drawn from the engine of the thread
+/// in a single flatArray() call, for the per-photon samplings (QE) which
+/// would otherwise call G4UniformRand() once per photon. The block is
+/// cleared at the start of every event, so that the numbers of an event
+/// all come from its own stream (see PhiloxEngine).
+
+class RandomBlock
+{
+  public:
+    explicit RandomBlock(std::size_t size = 256) : fValues(size), fNext(size) {}
+    ~RandomBlock() = default;
+
+    inline G4double Next();
+    // Discard the numbers left
+    void Clear() { fNext = fValues.size(); }
+
+  private:
+    void Refill();
+
+    std::vector<G4double> fValues;
+    std::size_t fNext;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4double RandomBlock::Next()
+{
+  if (fNext == fValues.size()) Refill();
+  return fValues[fNext++];
+}
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/RootOutputWriter.hh
+/// \brief Definition of the B1::RootOutputWriter class
+
+#ifndef B1RootOutputWriter_h
+#define B1RootOutputWriter_h 1
+
+#include "OutputWriter.hh"
+
+#include <vector>
+
+namespace B1
+{
+
+/// Output backend writing the Photons and Waveforms ntuples with
+/// G4AnalysisManager (ROOT file).
+///
+/// The ntuples are booked in the constructor, which must therefore be
+/// called on every thread before the first run. In multi-threaded mode
+/// each worker writes <fileName>_t<N>.root, listed in <fileName>.manifest
+/// at the end of the run, unless ntuple merging is enabled.
+
+class RootOutputWriter : public OutputWriter
+{
+  public:
+    RootOutputWriter();
+    ~RootOutputWriter() override = default;
+
+    // Must be set before the first run; see G4AnalysisManager
+    void SetNtupleMerging(G4bool merge, G4int nofReducedFiles);
+
+    void Open(const G4String& fileName, G4bool append) override;
+    void Close() override;
+
+    void FillPhotons(G4int eventID, const PhotonBuffer& photons) override;
+    void FillWaveform(G4int eventID, const PMTDigi& digi) override;
+
+  private:
+    G4int fPhotonsNtupleID = -1;
+    G4int fWaveformsNtupleID = -1;
+    G4bool fNtupleMerging = false;
+    std::vector<G4float> fWaveform;  // bound to the Waveforms ntuple
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -30,36 +30,95 @@
 #ifndef B1RunAction_h
 #define B1RunAction_h 1
 
+#include "PMTOccupancy.hh"
+#include "PhotonLimits.hh"
+#include "PhotonMapAccumulable.hh"
+#include "QECullingValidation.hh"
+#include "StepProfiler.hh"
+#include "TriggerEmulator.hh"
+
 #include "G4UserRunAction.hh"
 
 #include "G4Accumulable.hh"
 #include "globals.hh"
 
+#include <memory>
+
+class G4GenericMessenger;
 class G4Run;
 
 namespace B1
 {
 
+class ColumnarOutputWriter;
+class OutputWriter;
+class PhotonBuffer;
+class PMTDigi;
+class RootOutputWriter;
+class SummaryOutputWriter;
+class SteppingAction;
+
 /// Run action class
 ///
-/// In EndOfRunAction(), it calculates the dose in the selected volume
-/// from the energy deposit accumulated via stepping and event actions.
-/// The computed dose is then printed on the screen.
+/// In EndOfRunAction(), it prints the mean energy of the photons detected
+/// per event, accumulated via the event action. The master also starts and stops the live
+/// monitoring of the run (see RunMonitor) and reports the step profile
+/// (see StepProfiler).
 
 class RunAction : public G4UserRunAction
 {
   public:
     RunAction();
-    ~RunAction() override = default;
+    ~RunAction() override;
 
     void BeginOfRunAction(const G4Run*) override;
     void EndOfRunAction(const G4Run*) override;
 
     void AddEdep(G4double edep);
+    // event output, forwarded to the backend selected with /B1/output/format;
+    // without writeRows the photons only reach the summary histograms
+    void FillPhotons(G4int eventID, const PhotonBuffer& photons, G4bool writeRows = true);
+    void FillWaveform(G4int eventID, const PMTDigi& digi);
+    void FillCullingValidation(G4double energy, G4double time, G4bool reference, G4bool culled)
+    {
+      fCullingValidation.Fill(energy, time, reference, culled);
+    }
+    // photon map generation, see PhotonMapGenerator
+    void FillPhotonMap(G4int cell, G4int nofLaunched, const PhotonBuffer& photons)
+    {
+      fPhotonMap.Fill(cell, nofLaunched, photons);
+    }
+
+    void SetSteppingAction(SteppingAction* steppingAction) { fSteppingAction = steppingAction; }
+    StepProfiler* GetStepProfiler() { return &fStepProfiler; }
+    TriggerEmulator* GetTrigger() { return &fTrigger; }
 
   private:
+    void DefineCommands();
+
+    SteppingAction* fSteppingAction = nullptr;
+
+    std::unique_ptr<RootOutputWriter> fRootWriter;
+    std::unique_ptr<ColumnarOutputWriter> fColumnarWriter;
+    std::unique_ptr<SummaryOutputWriter> fSummaryWriter;
+    OutputWriter* fWriter = nullptr;  // backend of the current run
+    G4String fOutputFormat = "root";
+    G4String fFileName = "PhotonData";
+    G4bool fAppend = false;
+    G4bool fMergeNtuples = false;
+    G4int fNofReducedFiles = 0;
+    G4bool fNtupleMergingSet = false;
+
     G4Accumulable<G4double> fEdep = 0.;
     G4Accumulable<G4double> fEdep2 = 0.;
+    PhotonMapAccumulable fPhotonMap;
+    PMTOccupancy fPMTOccupancy;
+    PhotonLimits fPhotonLimits;
+    QECullingValidation fCullingValidation;
+    StepProfiler fStepProfiler;
+    TriggerEmulator fTrigger;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
 };
 
 }  // namespace B1
@@ -0,0 +1,156 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/RunMonitor.hh
+/// \brief Definition of the B1::RunMonitor class
+
+#ifndef B1RunMonitor_h
+#define B1RunMonitor_h 1
+
+#include "globals.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class G4GenericMessenger;
+class G4Run;
+
+namespace B1
+{
+
+/// Live throughput and progress of the runs (/B1/monitor/).
+///
+/// Every thread counts its events, steps and optical photons (created,
+/// tracked i.e. not culled at birth, detected) and its time spent in
+/// events in its own slot of counters, with relaxed atomic stores that
+/// no other thread writes. During a run, a reporting thread of the
+/// master reads the slots and writes, every /B1/monitor/interval, one JSON
+/// line with the rates over the interval, the events still queued and,
+/// per thread, the busy fraction and the number and age of the event in
+/// progress: a straggler shows as an old event on an otherwise idle
+/// job, and the time it waited for the asynchronous output writers (see
+/// AsyncOutput). The lines go to /B1/monitor/file, or to the standard
+/// output.
+///
+/// With /B1/monitor/socket, the same snapshot (rates since the last line)
+/// is sent as one JSON line to every client connecting to this local
+/// Unix-domain socket during a run, e.g. socat - UNIX-CONNECT:<path>.
+
+class RunMonitor
+{
+  public:
+    // Counters of one thread, written by this thread only
+    struct alignas(64) ThreadCounters
+    {
+        std::atomic<std::uint64_t> events{0};
+        std::atomic<std::uint64_t> steps{0};
+        std::atomic<std::uint64_t> photonsCreated{0};
+        std::atomic<std::uint64_t> photonsTracked{0};
+        std::atomic<std::uint64_t> photonsDetected{0};
+        std::atomic<std::int64_t> busyTime{0};  // in completed events [ns]
+        std::atomic<std::int64_t> eventStart{-1};  // event in progress [ns], else -1
+        std::atomic<G4int> eventID{-1};
+        std::atomic<std::int64_t> writerStall{0};  // waiting for the output writers [ns]
+    };
+
+    RunMonitor();
+    ~RunMonitor();
+
+    static RunMonitor* Instance() { return fgInstance; }
+
+    // Counters of the calling thread, nullptr if the monitor is off
+    static ThreadCounters* GetThreadCounters();
+    static void Increment(std::atomic<std::uint64_t>& counter)
+    {
+      counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    static void BeginEvent(ThreadCounters* counters, G4int eventID);
+    static void EndEvent(ThreadCounters* counters);
+
+    // Start and stop the reporting of a run (master thread)
+    void BeginOfRun(const G4Run* run);
+    void EndOfRun();
+
+  private:
+    struct Totals
+    {
+        std::uint64_t events = 0;
+        std::uint64_t steps = 0;
+        std::uint64_t photonsCreated = 0;
+        std::uint64_t photonsTracked = 0;
+        std::uint64_t photonsDetected = 0;
+    };
+
+    static std::int64_t Now();
+    void Report();
+    // JSON line of the current state; the rates are computed since the
+    // last update
+    std::string Snapshot(G4bool update, G4bool final = false);
+    void Write(const std::string& line) const;
+    void OpenSocket();
+    void CloseSocket();
+    void ServeRequests(G4int timeout);
+    void DefineCommands();
+
+    static inline RunMonitor* fgInstance = nullptr;
+    static constexpr G4int kMaxThreads = 1024;
+
+    G4bool fEnabled = false;
+    G4double fInterval = 0.;
+    G4String fFileName;
+    G4String fSocketPath;
+
+    // slot 0: master (sequential mode), slot i: worker i - 1
+    std::vector<ThreadCounters> fThreads;
+    std::atomic<G4int> fNofSlots{0};
+
+    // state of the current run, used by the reporting thread
+    G4int fRunID = -1;
+    G4int fNofEventsToProcess = 0;
+    std::int64_t fRunStart = 0;
+    std::int64_t fLastTime = 0;
+    Totals fLastTotals;
+    std::vector<std::int64_t> fLastBusy;
+    G4int fSocket = -1;
+
+    std::thread fThread;
+    std::mutex fMutex;
+    std::condition_variable fCondition;
+    G4bool fStop = false;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
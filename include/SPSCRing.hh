@@ -0,0 +1,98 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/SPSCRing.hh
+/// \brief Definition of the B1::SPSCRing class
+
+#ifndef B1SPSCRing_h
+#define B1SPSCRing_h 1
+
+#include "globals.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace B1
+{
+
+/// Bounded lock-free queue between one producer and one consumer thread.
+///
+/// The capacity is rounded up to a power of two. Each index is written by
+/// one side only; the release store of an index publishes the slot to the
+/// other side, which loads it with acquire. Both indices count up without
+/// wrapping, so that tail - head is the number of queued values.
+
+template <class T>
+class SPSCRing
+{
+  public:
+    explicit SPSCRing(std::size_t capacity)
+    {
+      std::size_t size = 1;
+      while (size < capacity) size <<= 1;
+      fSlots.resize(size);
+      fMask = size - 1;
+    }
+
+    SPSCRing(const SPSCRing&) = delete;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+
+    // Producer: false if the queue is full
+    G4bool Push(const T& value)
+    {
+      const std::size_t tail = fTail.load(std::memory_order_relaxed);
+      if (tail - fHead.load(std::memory_order_acquire) > fMask) return false;
+      fSlots[tail & fMask] = value;
+      fTail.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Consumer: false if the queue is empty
+    G4bool Pop(T& value)
+    {
+      const std::size_t head = fHead.load(std::memory_order_relaxed);
+      if (head == fTail.load(std::memory_order_acquire)) return false;
+      value = fSlots[head & fMask];
+      fHead.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    std::size_t GetCapacity() const { return fMask + 1; }
+
+  private:
+    std::vector<T> fSlots;
+    std::size_t fMask = 0;
+    // on separate cache lines: each is written by one side only
+    alignas(64) std::atomic<std::size_t> fHead{0};  // next slot to pop
+    alignas(64) std::atomic<std::size_t> fTail{0};  // next slot to push
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
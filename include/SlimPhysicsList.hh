@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/SlimPhysicsList.hh
+/// \brief Definition of the B1::SlimPhysicsList class
+
+#ifndef B1SlimPhysicsList_h
+#define B1SlimPhysicsList_h 1
+
+#include "G4VModularPhysicsList.hh"
+
+namespace B1
+{
+
+/// Modular physics list for MeV-scale studies of the Gd-LAB target:
+/// standard electromagnetic physics (as in the reference lists; the
+/// option 4 models are much slower and not needed for the energy deposit
+/// of MeV positrons and gammas), decays and the high-precision neutron
+/// physics needed for the moderation and capture on Gd (NeutronHPPhysics).
+/// Without the hadronic models of the reference lists, it initialises
+/// much faster and takes less memory per thread. The optical physics is
+/// added by PhysicsListFactory.
+///
+/// The ParticleHP models stop at 20 MeV and no other neutron model is
+/// registered: the list is not meant for neutrons above 20 MeV (e.g. from
+/// cosmic muons), which have no hadronic interaction in it.
+
+class SlimPhysicsList : public G4VModularPhysicsList
+{
+  public:
+    SlimPhysicsList();
+    ~SlimPhysicsList() override = default;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/SpectralDataLoader.hh
+/// \brief Definition of the B1::SpectralDataLoader class
+
+#ifndef B1SpectralDataLoader_h
+#define B1SpectralDataLoader_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+namespace B1
+{
+
+/// Loader of spectral data files: text files of (wavelength in nm,
+/// intensity) pairs, one per line, with optional # comments.
+///
+/// The file is returned as a table sorted in photon energy and normalised
+/// to a maximum of 1. The processed table is kept in a binary cache file
+/// named after the 64-bit FNV-1a hash of the file content, so that it is
+/// parsed only once for a given content. The cache directory is, in order
+/// of precedence, the one given to the constructor, $B1_CACHE_DIR,
+/// $XDG_CACHE_HOME/exampleB1 or ~/.cache/exampleB1.
+
+class SpectralDataLoader
+{
+  public:
+    SpectralDataLoader(const G4String& cacheDirectory = "");
+    ~SpectralDataLoader() = default;
+
+    // Expand a leading ~ and the $VAR and ${VAR} environment variables
+    static G4String ResolvePath(const G4String& path);
+    // 64-bit FNV-1a hash
+    static std::uint64_t Hash(const char* data, std::size_t size);
+
+    // Load the file; false if it cannot be read or holds no data
+    G4bool Load(const G4String& fileName, std::vector<G4double>& energies,
+                std::vector<G4double>& values) const;
+
+    const G4String& GetCacheDirectory() const { return fCacheDirectory; }
+
+  private:
+    static void Parse(const char* data, std::size_t size, std::vector<G4double>& energies,
+                      std::vector<G4double>& values);
+    G4String GetCacheFileName(std::uint64_t hash) const;
+    G4bool ReadCache(std::uint64_t hash, std::vector<G4double>& energies,
+                     std::vector<G4double>& values) const;
+    void WriteCache(std::uint64_t hash, const std::vector<G4double>& energies,
+                    const std::vector<G4double>& values) const;
+
+    G4String fCacheDirectory;  // no cache if empty
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,96 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/SpectralTable.hh
+/// \brief Definition of the B1::SpectralTable class
+
+#ifndef B1SpectralTable_h
+#define B1SpectralTable_h 1
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace B1
+{
+
+/// A spectral curve tabulated on a uniform photon-energy grid.
+///
+/// Lookups are O(1): the bin is computed from the energy and the value
+/// is linearly interpolated; energies outside the grid are clamped to
+/// the edge values. Values() is the batch version for arrays of photon
+/// energies, written without branches so that it can be vectorised.
+
+class SpectralTable
+{
+  public:
+    SpectralTable() = default;
+    SpectralTable(G4double eMin, G4double eMax, std::size_t nofPoints);
+    ~SpectralTable() = default;
+
+    // Fill with a constant
+    void Fill(G4double value);
+    // Fill by linear interpolation of the (energy, value) points, which
+    // must be sorted in energy; outside their range use the edge values,
+    // or zero if requested
+    void Fill(const std::vector<G4double>& energies, const std::vector<G4double>& values,
+              G4bool zeroOutside = false);
+    // Scale all values so that the maximum is 1
+    void Normalise();
+
+    inline G4double Value(G4double energy) const;
+    void Values(const G4double* energies, G4double* values, std::size_t n) const;
+
+    const std::vector<G4double>& GetEnergies() const { return fEnergies; }
+    const std::vector<G4double>& GetValues() const { return fValues; }
+    std::size_t GetNofPoints() const { return fValues.size(); }
+
+  private:
+    void UpdateSlopes();
+
+    G4double fEMin = 0.;
+    G4double fInvStep = 0.;
+    G4double fXMax = 0.;  // last grid index, as a double
+    std::vector<G4double> fEnergies;
+    std::vector<G4double> fValues;
+    std::vector<G4double> fSlopes;  // fValues[i+1] - fValues[i]
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4double SpectralTable::Value(G4double energy) const
+{
+  G4double x = std::min(std::max((energy - fEMin) * fInvStep, 0.), fXMax);
+  auto i = static_cast<std::size_t>(x);
+  return fValues[i] + (x - i) * fSlopes[i];
+}
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,103 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/StackingAction.hh
+/// \brief Definition of the B1::StackingAction class
+
+#ifndef B1StackingAction_h
+#define B1StackingAction_h 1
+
+#include "RandomBlock.hh"
+#include "RunMonitor.hh"
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+#include <memory>
+
+class G4GenericMessenger;
+class G4ParticleDefinition;
+
+namespace B1
+{
+
+class SpectralTable;
+class TriggerEmulator;
+
+/// Stacking action class
+///
+/// Most optical photons are never detected: the photocathode QE rejects
+/// about 72% of those reaching a PMT. As the QE depends only on the
+/// photon energy, which does not change during tracking, it is sampled
+/// when the photon is created: rejected photons are killed before they
+/// are tracked and the survivors are tagged with a PhotonInformation so
+/// that PMTSD does not apply the QE again. Photons created after the end
+/// of an optional time window (/B1/stacking/timeWindow) cannot be
+/// detected within it and are killed as well.
+///
+/// With /B1/stacking/validate, all photons are tracked and PMTSD samples
+/// the QE as without culling; the spectra of the photons detected either
+/// way are compared at the end of the run (see QECullingValidation).
+///
+/// When the trigger emulation stops the hopeless events, the tracked
+/// photons are counted and held in the waiting stack until all the other
+/// particles are tracked (see TriggerEmulator).
+
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    StackingAction();
+    ~StackingAction() override;
+
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+    void NewStage() override;
+    void PrepareNewEvent() override;
+
+    void SetTrigger(TriggerEmulator* trigger) { fTrigger = trigger; }
+
+  private:
+    // Stack of a photon to be tracked
+    G4ClassificationOfNewTrack TrackPhoton();
+    void DefineCommands();
+
+    const G4ParticleDefinition* fOpticalPhoton = nullptr;
+    const SpectralTable* fQE = nullptr;
+    G4double fQEScale = 1.;
+    G4bool fEnabled = true;
+    G4bool fValidation = false;
+    G4double fTimeWindow = 0.;  // no cut if 0
+    RandomBlock fRandoms;
+    RunMonitor::ThreadCounters* fMonitor = nullptr;
+    TriggerEmulator* fTrigger = nullptr;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
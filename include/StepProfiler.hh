@@ -0,0 +1,133 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/StepProfiler.hh
+/// \brief Definition of the B1::StepProfiler class
+
+#ifndef B1StepProfiler_h
+#define B1StepProfiler_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+class G4GenericMessenger;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4Step;
+class G4Track;
+class G4VProcess;
+
+namespace B1
+{
+
+/// Profiler of the tracking, enabled with /B1/profile/enable: number of
+/// steps and tracks, track length and wall time per (logical volume,
+/// particle, creator process).
+///
+/// Each thread counts in a table keyed by the volume instance ID and
+/// small particle and process indices; consecutive steps of a track in the
+/// same volume reuse the last entry. The wall time of a step is the time
+/// since the previous step (or the start of the track), which includes the
+/// user actions. At the end of the run, the table is converted to names
+/// and merged; the master prints the entries taking most time and writes
+/// all of them to a CSV file (/B1/profile/fileName).
+///
+/// The stepping action only holds a pointer to the profiler while it is
+/// active, so that the disabled profiler costs one pointer test per step.
+
+class StepProfiler : public G4VAccumulable
+{
+  public:
+    StepProfiler();
+    ~StepProfiler() override;
+
+    // Activation for the run, set from /B1/profile/enable
+    void BeginOfRun();
+    G4bool IsActive() const { return fActive; }
+
+    // called by the tracking and stepping actions while active
+    void BeginTrack(const G4Track* track);
+    void Step(const G4Step* step);
+
+    // Move the thread table into the merged entries, before Merge()
+    void EndOfRun();
+    // Print the sorted table and write the report (master)
+    void Report() const;
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+    void Print(G4PrintOptions options = G4PrintOptions()) const override;
+
+  private:
+    struct Entry
+    {
+        std::uint64_t nofSteps = 0;
+        std::uint64_t nofTracks = 0;
+        G4double length = 0.;
+        G4double wallTime = 0.;  // s
+    };
+    // volume, particle, creator process
+    using Key = std::tuple<std::string, std::string, std::string>;
+
+    Entry& FindEntry(const G4LogicalVolume* volume, const G4Track* track);
+    std::vector<std::pair<Key, Entry>> Sorted() const;
+    void Write() const;
+    void DefineCommands();
+
+    G4bool fEnabled = false;
+    G4bool fActive = false;
+    G4String fFileName = "Profile.csv";
+    G4int fNofRows = 20;
+
+    // thread table, key = volume instance ID << 32 | particle << 16 | process
+    std::unordered_map<std::uint64_t, Entry> fTable;
+    std::vector<const G4ParticleDefinition*> fParticles;
+    std::vector<const G4VProcess*> fProcesses;  // [0] = primary
+    // last step
+    const G4Track* fTrack = nullptr;
+    const G4LogicalVolume* fVolume = nullptr;
+    Entry* fEntry = nullptr;
+    std::int64_t fLastTime = 0;  // ns
+
+    std::map<Key, Entry> fEntries;  // merged
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
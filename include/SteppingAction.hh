@@ -1,29 +1,108 @@
-#pragma once
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/SteppingAction.hh
+/// \brief Definition of the B1::SteppingAction class
+
+#ifndef B1SteppingAction_h
+#define B1SteppingAction_h 1
+
+#include "RunMonitor.hh"
+
 #include "G4UserSteppingAction.hh"
-#include "G4LogicalVolume.hh"
+#include "globals.hh"
+
 #include <vector>
 
-namespace B1 {
-class EventAction;
-class DetectorConstruction;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+
+namespace B1
+{
+
+class PhotonLimits;
+class StepProfiler;
+
+/// Stepping action class
+///
+/// Steps are routed through a flat table of handlers indexed by
+/// (particle slot, logical volume instance ID). The table is rebuilt by
+/// BuildDispatchTable() at the start of each run, so that it follows
+/// geometry changes. Optical photons, which make most of the steps, are
+/// recognised with a single pointer compare and return immediately when
+/// no handler is registered for them, after the check of the photon kill
+/// limits when they are set. The step profiler sees every step while it
+/// is active.
+///
+/// The photons are scored by PMTSD, so the example itself registers no
+/// handler; derived actions add theirs with SetHandler().
 
 class SteppingAction : public G4UserSteppingAction
 {
-public:
-    SteppingAction(EventAction* eventAction);
-    virtual ~SteppingAction() = default;
+  public:
+    SteppingAction() = default;
+    ~SteppingAction() override = default;
+
+    void UserSteppingAction(const G4Step*) override;
+
+    void BuildDispatchTable();
+    // Step counter of the run monitor, nullptr if off
+    void SetMonitorCounters(RunMonitor::ThreadCounters* counters) { fMonitor = counters; }
+    // Step profiler, nullptr if not active
+    void SetProfiler(StepProfiler* profiler) { fProfiler = profiler; }
+    // Optical photon kill limits, nullptr if none
+    void SetPhotonLimits(PhotonLimits* limits) { fPhotonLimits = limits; }
+
+  protected:
+    using Handler = void (SteppingAction::*)(const G4Step*);
 
-    virtual void UserSteppingAction(const G4Step* step) override;
+    enum ParticleSlot
+    {
+      kOpticalPhoton = 0,
+      kOtherParticle,
+      kNofParticleSlots
+    };
 
-private:
-    EventAction* fEventAction;
-    G4LogicalVolume* fScoringVolume = nullptr;
+    // Register a handler for the steps of a particle slot starting in a
+    // volume; to be called after BuildDispatchTable()
+    void SetHandler(ParticleSlot slot, const G4LogicalVolume* volume, Handler handler);
 
-    // PMT квантовая эффективность
-    std::vector<G4double> fPhotonEnergies; // энергии фотонов (eV)
-    std::vector<G4double> fQE;             // соответствующая QE (0..1)
+  private:
+    RunMonitor::ThreadCounters* fMonitor = nullptr;
+    StepProfiler* fProfiler = nullptr;
+    PhotonLimits* fPhotonLimits = nullptr;
+    const G4ParticleDefinition* fOpticalPhoton = nullptr;
 
-    int fNumQEPoints;
-    G4double GetQE(G4double energy);
+    std::vector<Handler> fTable;  // [slot * fNofVolumes + volume instance ID]
+    std::size_t fNofVolumes = 0;
+    G4bool fSlotActive[kNofParticleSlots] = {false, false};
 };
-} // namespace B1
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
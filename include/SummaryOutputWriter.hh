@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/SummaryOutputWriter.hh
+/// \brief Definition of the B1::SummaryOutputWriter class
+
+#ifndef B1SummaryOutputWriter_h
+#define B1SummaryOutputWriter_h 1
+
+#include "OutputWriter.hh"
+
+namespace B1
+{
+
+class PMTOccupancy;
+
+/// Output backend writing only distributions, for the production runs:
+///  - H1 Energy (eV) and Time (ns) of the detected photons,
+///  - H1 Photoelectrons per event and Charge (p.e.) of the PMT waveforms,
+///  - H2 EnergyVsTime of the detected photons,
+/// booked with G4AnalysisManager, filled per thread and merged into
+/// <fileName>.root by the master; the ntuples are deactivated. The
+/// photoelectrons and occupancy per PMT are accumulated in a PMTOccupancy
+/// merged over the threads and written by the master to
+/// <fileName>_pmt.csv.
+///
+/// The histograms are booked in the constructor, which must therefore be
+/// called on every thread before the first run.
+
+class SummaryOutputWriter : public OutputWriter
+{
+  public:
+    SummaryOutputWriter(PMTOccupancy& occupancy);
+    ~SummaryOutputWriter() override = default;
+
+    void Open(const G4String& fileName, G4bool append) override;
+    void Close() override;
+
+    void FillPhotons(G4int eventID, const PhotonBuffer& photons) override;
+    void FillWaveform(G4int eventID, const PMTDigi& digi) override;
+
+  private:
+    PMTOccupancy& fOccupancy;
+    G4String fFileName;
+
+    G4int fEnergyH1ID = -1;
+    G4int fTimeH1ID = -1;
+    G4int fPhotoelectronsH1ID = -1;
+    G4int fChargeH1ID = -1;
+    G4int fEnergyTimeH2ID = -1;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
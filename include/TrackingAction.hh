@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/TrackingAction.hh
+/// \brief Definition of the B1::TrackingAction class
+
+#ifndef B1TrackingAction_h
+#define B1TrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+class G4ParticleDefinition;
+
+namespace B1
+{
+
+class StepProfiler;
+class TriggerEmulator;
+
+/// Tracking action class
+///
+/// Counts the tracks and starts the timing of their first step for the
+/// step profiler, when it is active, and tells the trigger emulation when
+/// an optical photon of the photon stage is done.
+
+class TrackingAction : public G4UserTrackingAction
+{
+  public:
+    TrackingAction(StepProfiler* profiler, TriggerEmulator* trigger);
+    ~TrackingAction() override = default;
+
+    void PreUserTrackingAction(const G4Track* track) override;
+    void PostUserTrackingAction(const G4Track* track) override;
+
+  private:
+    StepProfiler* fProfiler = nullptr;
+    TriggerEmulator* fTrigger = nullptr;
+    const G4ParticleDefinition* fOpticalPhoton = nullptr;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,122 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/include/TriggerEmulator.hh
+/// \brief Definition of the B1::TriggerEmulator class
+
+#ifndef B1TriggerEmulator_h
+#define B1TriggerEmulator_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
+
+class G4GenericMessenger;
+
+namespace B1
+{
+
+/// Emulation of the trigger (/B1/trigger/): an event is accepted when at
+/// least minPhotoelectrons photoelectrons or minPMTs PMTs with a
+/// photoelectron are detected within the trigger window.
+///
+/// The running photoelectron count and PMT occupancy of the event are kept
+/// as the PMTs are hit, and the event is aborted as soon as its decision
+/// can no longer change:
+///  - stopWhenAccepted: once the event is accepted,
+///  - stopWhenHopeless: once the photons still to be tracked cannot reach
+///    the thresholds. Each tracked photon gives at most one photoelectron:
+///    the stacking action holds the optical photons back until all the
+///    other particles are tracked, so that their number is known.
+/// The output of the stopped events is partial. The numbers of accepted
+/// and stopped events are merged over the threads and printed at the end
+/// of the run.
+
+class TriggerEmulator : public G4VAccumulable
+{
+  public:
+    TriggerEmulator();
+    ~TriggerEmulator() override;
+
+    // Activation for the run, if enabled with a threshold
+    void BeginOfRun();
+    G4bool IsActive() const { return fActive; }
+    // The optical photons are tracked in a separate stack stage
+    G4bool UsesPhotonStage() const { return fActive && fStopWhenHopeless; }
+
+    void BeginEvent();
+    // Optical photons to be tracked in the photon stage, and tracked
+    void AddPhoton() { ++fNofPendingPhotons; }
+    void EndPhoton();
+    // All other particles are tracked
+    void BeginPhotonStage();
+    void AddPhotoelectron(G4int pmtID, G4double time);
+    void EndEvent();
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+    void Print(G4PrintOptions options = G4PrintOptions()) const override;
+
+  private:
+    G4bool IsHopeless() const;
+    void Stop(G4double& counter);
+    void DefineCommands();
+
+    // settings
+    G4bool fEnabled = false;
+    G4int fMinPhotoelectrons = 0;  // not used if 0
+    G4int fMinPMTs = 0;  // not used if 0
+    G4double fWindow = 0.;  // whole event if 0
+    G4bool fStopWhenAccepted = true;
+    G4bool fStopWhenHopeless = true;
+
+    // event
+    G4bool fActive = false;
+    G4int fNofPhotoelectrons = 0;
+    G4int fNofHitPMTs = 0;
+    std::vector<char> fHitPMTs;
+    G4long fNofPendingPhotons = 0;
+    G4bool fPhotonStage = false;
+    G4bool fAccepted = false;
+    G4bool fStopped = false;
+
+    // run
+    G4double fNofEvents = 0.;
+    G4double fNofAccepted = 0.;
+    G4double fNofStoppedAccepted = 0.;
+    G4double fNofStoppedHopeless = 0.;
+
+    std::unique_ptr<G4GenericMessenger> fMessenger;
+};
+
+}  // namespace B1
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -30,9 +30,14 @@
 #include "ActionInitialization.hh"
 
 #include "EventAction.hh"
+#include "PMTDigitizer.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
+#include "StackingAction.hh"
 #include "SteppingAction.hh"
+#include "TrackingAction.hh"
+
+#include "G4DigiManager.hh"
 
 namespace B1
 {
@@ -57,7 +62,18 @@ void ActionInitialization::Build() const
   auto eventAction = new EventAction(runAction);
   SetUserAction(eventAction);
 
-  SetUserAction(new SteppingAction(eventAction));
+  auto digitizer = new PMTDigitizer("PMTDigitizer", eventAction->GetPhotonBuffer());
+  G4DigiManager::GetDMpointer()->AddNewModule(digitizer);
+
+  auto stackingAction = new StackingAction;
+  stackingAction->SetTrigger(runAction->GetTrigger());
+  SetUserAction(stackingAction);
+
+  SetUserAction(new TrackingAction(runAction->GetStepProfiler(), runAction->GetTrigger()));
+
+  auto steppingAction = new SteppingAction;
+  SetUserAction(steppingAction);
+  runAction->SetSteppingAction(steppingAction);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
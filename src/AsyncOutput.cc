@@ -0,0 +1,249 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/AsyncOutput.cc
+/// \brief Implementation of the B1::AsyncOutput class
+
+#include "AsyncOutput.hh"
+
+#include "ColumnarOutputWriter.hh"
+
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+
+#include <algorithm>
+#include <chrono>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AsyncOutput::AsyncOutput()
+{
+  fgInstance = this;
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AsyncOutput::~AsyncOutput()
+{
+  // the channels are flushed at the end of every run
+  fStop.store(true, std::memory_order_release);
+  for (auto& thread : fThreads) {
+    thread.join();
+  }
+  fgInstance = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::int64_t AsyncOutput::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AsyncOutput::Channel* AsyncOutput::Connect(ColumnarOutputWriter* writer)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  const G4int index = fNofChannels.load(std::memory_order_relaxed);
+  if (index >= kMaxChannels) {
+    G4ExceptionDescription ed;
+    ed << "More than " << kMaxChannels << " output channels: writing synchronously.";
+    G4Exception("AsyncOutput::Connect()", "B1Async001", JustWarning, ed);
+    return nullptr;
+  }
+
+  const auto queueSize = static_cast<std::size_t>(std::max(fQueueSize, 1));
+  auto channel = std::make_unique<Channel>(queueSize);
+  channel->writer = writer;
+  for (std::size_t i = 0; i < queueSize; ++i) {
+    channel->records.push_back(std::make_unique<Record>());
+    channel->empty.Push(channel->records.back().get());
+  }
+
+  // publish the channel to the writer threads
+  fChannels[index].store(channel.get(), std::memory_order_release);
+  fNofChannels.store(index + 1, std::memory_order_release);
+  fOwnedChannels.push_back(std::move(channel));
+
+  if (fThreads.empty()) {
+    fNofThreads = std::max(fNofWriterThreads, 1);
+    for (G4int i = 0; i < fNofThreads; ++i) {
+      fThreads.emplace_back(&AsyncOutput::Write, this, i);
+    }
+  }
+  return fOwnedChannels.back().get();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AsyncOutput::Record& AsyncOutput::Acquire(Channel& channel)
+{
+  Record* record = nullptr;
+  if (channel.empty.Pop(record)) return *record;
+
+  // backpressure: all the records are queued or being written
+  const std::int64_t start = Now();
+  while (!channel.empty.Pop(record)) {
+    std::this_thread::yield();
+  }
+  const std::int64_t stall = Now() - start;
+  channel.stallTime += stall;
+  if (channel.monitor) {
+    auto& counter = channel.monitor->writerStall;
+    counter.store(counter.load(std::memory_order_relaxed) + stall, std::memory_order_relaxed);
+  }
+  return *record;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncOutput::Push(Channel& channel, Record& record)
+{
+  // cannot fail: the ring holds all the records of the channel
+  channel.full.Push(&record);
+  ++channel.nofPushed;
+  channel.maxDepth = std::max(
+    channel.maxDepth, channel.nofPushed - channel.nofWritten.load(std::memory_order_relaxed));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncOutput::Flush(Channel& channel)
+{
+  const std::int64_t start = Now();
+  // acquire: the files of the writer are up to date afterwards
+  while (channel.nofWritten.load(std::memory_order_acquire) != channel.nofPushed) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  fStatistics.nofRecords += channel.nofPushed;
+  fStatistics.maxDepth = std::max(fStatistics.maxDepth, channel.maxDepth);
+  fStatistics.stallTime += channel.stallTime;
+  fStatistics.flushTime += Now() - start;
+
+  channel.nofPushed = 0;
+  channel.nofWritten.store(0, std::memory_order_relaxed);
+  channel.maxDepth = 0;
+  channel.stallTime = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncOutput::Write(G4int index)
+{
+  // writer thread: serves the channels index, index + fNofThreads, ...
+  G4int nofIdleLoops = 0;
+  while (true) {
+    // read before the queues: no record is pushed once it is set
+    const G4bool stop = fStop.load(std::memory_order_acquire);
+    G4bool written = false;
+    const G4int nofChannels = fNofChannels.load(std::memory_order_acquire);
+    for (G4int i = index; i < nofChannels; i += fNofThreads) {
+      Channel* channel = fChannels[i].load(std::memory_order_acquire);
+      Record* record = nullptr;
+      while (channel->full.Pop(record)) {
+        if (record->waveform) {
+          channel->writer->WriteWaveform(record->eventID, record->digi);
+        }
+        else {
+          channel->writer->WritePhotons(record->eventID, record->photons);
+        }
+        channel->empty.Push(record);
+        channel->nofWritten.fetch_add(1, std::memory_order_release);
+        written = true;
+      }
+    }
+    if (written) {
+      nofIdleLoops = 0;
+      continue;
+    }
+    if (stop) return;
+    // back off up to 1 ms while idle
+    const G4int sleep = std::min(10 << std::min(nofIdleLoops++, 7), 1000);
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncOutput::EndOfRun()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (fStatistics.nofRecords > 0) {
+    G4cout << G4endl << " Asynchronous output: " << fStatistics.nofRecords << " records, "
+           << fNofThreads << " writer thread(s), queue size " << fQueueSize << G4endl
+           << "   writer stall: " << fStatistics.stallTime * 1e-9
+           << " s, flush at end of run: " << fStatistics.flushTime * 1e-9
+           << " s, largest queue depth: " << fStatistics.maxDepth << G4endl;
+  }
+  fStatistics = Statistics();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncOutput::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/output/async/",
+                                                    "Asynchronous columnar output");
+
+  fMessenger->DeclareMethod("enable", &AsyncOutput::SetEnabled)
+    .SetGuidance("Write the columnar files from dedicated writer threads, fed by")
+    .SetGuidance("a bounded queue per event thread.")
+    .SetParameterName("enable", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("writerThreads", fNofWriterThreads)
+    .SetGuidance("Set the number of writer threads.")
+    .SetGuidance("Takes effect at the first asynchronous run.")
+    .SetParameterName("nofThreads", false)
+    .SetRange("nofThreads>=1")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("queueSize", fQueueSize)
+    .SetGuidance("Set the number of records (photons of an event, or a waveform)")
+    .SetGuidance("queued per event thread before it waits for the writers.")
+    .SetGuidance("Takes effect at the first asynchronous run.")
+    .SetParameterName("nofRecords", false)
+    .SetRange("nofRecords>=1")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,267 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/CampaignRunner.cc
+/// \brief Implementation of the B1::CampaignRunner class
+
+#include "CampaignRunner.hh"
+
+#include "DetectorConstruction.hh"
+
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UIcommand.hh"
+#include "G4UImanager.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace B1
+{
+
+namespace
+{
+// Columns of the configuration table and their default units
+const std::map<G4String, G4double> kColumnUnits = {
+  {"absLengthGd", m}, {"absLengthLAB", m}, {"reflectivity", 1.},   {"qe", 1.},
+  {"yield", 1. / MeV}, {"energy", MeV},    {"events", 1.}};
+
+// Unit of a column header "name[unit]"; units of the form 1/unit are accepted
+G4bool ParseHeader(const G4String& header, G4String& name, G4double& unit)
+{
+  std::size_t bracket = header.find('[');
+  name = header.substr(0, bracket);
+  if (name == "id") return true;
+  auto column = kColumnUnits.find(name);
+  if (column == kColumnUnits.end()) return false;
+  unit = column->second;
+  if (bracket == std::string::npos) return true;
+
+  G4String unitName = header.substr(bracket + 1, header.find(']') - bracket - 1);
+  G4bool inverse = unitName.rfind("1/", 0) == 0;
+  if (inverse) unitName = unitName.substr(2);
+  unit = G4UIcommand::ValueOf(unitName.c_str());
+  if (unit <= 0.) return false;
+  if (inverse) unit = 1. / unit;
+  return true;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CampaignRunner::CampaignRunner(DetectorConstruction* detector) : fDetector(detector)
+{
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CampaignRunner::~CampaignRunner() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CampaignRunner::ReadTable(std::vector<Configuration>& configurations) const
+{
+  std::ifstream in(fTableFile);
+  if (!in) {
+    G4ExceptionDescription ed;
+    ed << "Cannot open the campaign table " << fTableFile << ".";
+    G4Exception("CampaignRunner::ReadTable()", "B1Campaign001", JustWarning, ed);
+    return false;
+  }
+
+  std::vector<G4String> names;
+  std::vector<G4double> units;
+  std::string line;
+  for (G4int lineNo = 1; std::getline(in, line); ++lineNo) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream is(line);
+    std::vector<G4String> fields;
+    for (std::string field; is >> field;) fields.push_back(field);
+    if (fields.empty()) continue;
+
+    // header
+    if (names.empty()) {
+      for (const auto& header : fields) {
+        G4String name;
+        G4double unit = 1.;
+        if (!ParseHeader(header, name, unit)) {
+          G4ExceptionDescription ed;
+          ed << "Unknown column " << header << " in the campaign table " << fTableFile << ".";
+          G4Exception("CampaignRunner::ReadTable()", "B1Campaign002", JustWarning, ed);
+          return false;
+        }
+        names.push_back(name);
+        units.push_back(unit);
+      }
+      continue;
+    }
+
+    // configuration
+    if (fields.size() != names.size()) {
+      G4ExceptionDescription ed;
+      ed << fTableFile << ":" << lineNo << ": " << fields.size() << " values for "
+         << names.size() << " columns.";
+      G4Exception("CampaignRunner::ReadTable()", "B1Campaign003", JustWarning, ed);
+      return false;
+    }
+    Configuration configuration;
+    configuration.id = std::to_string(configurations.size());
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+      if (names[i] == "id") {
+        configuration.id = fields[i];
+        continue;
+      }
+      char* end = nullptr;
+      G4double value = std::strtod(fields[i].c_str(), &end);
+      if (*end != '\0') {
+        G4ExceptionDescription ed;
+        ed << fTableFile << ":" << lineNo << ": bad value " << fields[i] << ".";
+        G4Exception("CampaignRunner::ReadTable()", "B1Campaign003", JustWarning, ed);
+        return false;
+      }
+      configuration.values[names[i]] = value * units[i];
+    }
+    configurations.push_back(configuration);
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CampaignRunner::Apply(const Configuration& configuration) const
+{
+  // the property tables are shared by all threads and changed between runs
+  for (const auto& [name, value] : configuration.values) {
+    if (name == "absLengthGd") fDetector->SetAbsLengthGd(value);
+    else if (name == "absLengthLAB") fDetector->SetAbsLengthLAB(value);
+    else if (name == "reflectivity") fDetector->SetMylarReflectivity(value);
+    else if (name == "qe") fDetector->SetPhotocathodeQE(value);
+    else if (name == "yield") fDetector->SetScintillationYield(value);
+  }
+
+  // the gun and the output file name of the workers, with the next run
+  auto uiManager = G4UImanager::GetUIpointer();
+  auto energy = configuration.values.find("energy");
+  if (energy != configuration.values.end()) {
+    uiManager->ApplyCommand("/gun/energy " + std::to_string(energy->second / MeV) + " MeV");
+  }
+  uiManager->ApplyCommand("/B1/output/fileName " + fFileName + "_" + configuration.id);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CampaignRunner::Run()
+{
+  std::vector<Configuration> configurations;
+  if (!ReadTable(configurations)) return;
+
+  auto nofConfigs = static_cast<G4int>(configurations.size());
+  G4int lastConfig = (fLastConfig < 0) ? nofConfigs - 1 : std::min(fLastConfig, nofConfigs - 1);
+
+  std::ofstream log(fFileName + ".campaign", std::ios::app);
+  auto runManager = G4RunManager::GetRunManager();
+  for (G4int i = fFirstConfig; i <= lastConfig; ++i) {
+    const Configuration& configuration = configurations[i];
+    auto events = configuration.values.find("events");
+    G4int nofEvents = (events != configuration.values.end()) ? static_cast<G4int>(events->second)
+                                                             : fEventsPerConfig;
+
+    G4cout << " Campaign configuration " << configuration.id << " (" << i + 1 << " of "
+           << nofConfigs << "): " << nofEvents << " events" << G4endl;
+    Apply(configuration);
+
+    auto start = std::chrono::steady_clock::now();
+    runManager->BeamOn(nofEvents);
+    std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+
+    log << configuration.id << " " << nofEvents << " " << fFileName << "_" << configuration.id
+        << " " << elapsed.count() << "s";
+    for (const auto& [name, value] : configuration.values) {
+      if (name != "events") log << " " << name << "=" << value / kColumnUnits.at(name);
+    }
+    log << std::endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CampaignRunner::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/campaign/",
+                                                    "Runs over a table of configurations");
+
+  fMessenger->DeclareProperty("file", fTableFile)
+    .SetGuidance("Table of configurations: a header line of column names, among")
+    .SetGuidance("  id absLengthGd absLengthLAB reflectivity qe yield energy events,")
+    .SetGuidance("each optionally followed by a unit in brackets, e.g. energy[keV],")
+    .SetGuidance("then one configuration per line.")
+    .SetParameterName("fileName", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("fileName", fFileName)
+    .SetGuidance("Output file name prefix: the output of a configuration goes to")
+    .SetGuidance("<fileName>_<id> and the campaign log to <fileName>.campaign.")
+    .SetParameterName("fileName", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("eventsPerConfig", fEventsPerConfig)
+    .SetGuidance("Number of events of a configuration without an events column.")
+    .SetParameterName("n", false)
+    .SetRange("n>0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("firstConfig", fFirstConfig)
+    .SetGuidance("First configuration (line of the table, from 0) run by this process.")
+    .SetParameterName("index", false)
+    .SetRange("index>=0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("lastConfig", fLastConfig)
+    .SetGuidance("Last configuration run by this process (-1 = the last one).")
+    .SetParameterName("index", false)
+    .SetRange("index>=-1")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("run", &CampaignRunner::Run)
+    .SetGuidance("Run the selected configurations of the table.")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
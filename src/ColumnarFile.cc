@@ -0,0 +1,203 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/ColumnarFile.cc
+/// \brief Implementation of the B1::ColumnarFile class
+
+#include "ColumnarFile.hh"
+
+#include "G4Exception.hh"
+
+#include <cstring>
+#include <utility>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ColumnarFile::~ColumnarFile()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarFile::AddColumn(const G4String& name, columnar::ColumnType type, G4int count)
+{
+  Column column;
+  std::memset(&column.desc, 0, sizeof(column.desc));
+  std::strncpy(column.desc.name, name.c_str(), sizeof(column.desc.name) - 1);
+  column.desc.type = static_cast<std::uint8_t>(type);
+  column.desc.count = static_cast<std::uint32_t>(count);
+  fColumns.push_back(std::move(column));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarFile::ClearColumns()
+{
+  fColumns.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ColumnarFile::Open(const G4String& fileName, G4bool append)
+{
+  Close();
+  fFileName = fileName;
+  fIndex.clear();
+  fNofRows = 0;
+  fPendingRows = 0;
+  for (auto& column : fColumns) column.data.clear();
+
+  if (append) {
+    fFile = std::fopen(fileName.c_str(), "r+b");
+    if (fFile) return OpenForAppend();
+  }
+
+  fFile = std::fopen(fileName.c_str(), "wb");
+  if (!fFile) {
+    G4ExceptionDescription ed;
+    ed << "Cannot open " << fileName << " for writing.";
+    G4Exception("ColumnarFile::Open()", "B1Columnar001", JustWarning, ed);
+    return false;
+  }
+
+  columnar::FileHeader header;
+  std::memcpy(header.magic, columnar::kMagic, sizeof(header.magic));
+  header.version = columnar::kVersion;
+  header.nofColumns = static_cast<std::uint32_t>(fColumns.size());
+  std::fwrite(&header, sizeof(header), 1, fFile);
+  for (const auto& column : fColumns) {
+    std::fwrite(&column.desc, sizeof(column.desc), 1, fFile);
+  }
+  fOffset = sizeof(header) + fColumns.size() * sizeof(columnar::ColumnDesc);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ColumnarFile::OpenForAppend()
+{
+  // Check that the header matches the declared columns
+  columnar::FileHeader header;
+  G4bool valid = std::fread(&header, sizeof(header), 1, fFile) == 1
+                 && std::memcmp(header.magic, columnar::kMagic, sizeof(header.magic)) == 0
+                 && header.version == columnar::kVersion
+                 && header.nofColumns == fColumns.size();
+  for (std::size_t i = 0; valid && i < fColumns.size(); ++i) {
+    columnar::ColumnDesc desc;
+    valid = std::fread(&desc, sizeof(desc), 1, fFile) == 1
+            && std::memcmp(&desc, &fColumns[i].desc, sizeof(desc)) == 0;
+  }
+
+  // Read the trailer and the chunk index
+  columnar::Trailer trailer;
+  valid = valid && fseeko(fFile, -static_cast<off_t>(sizeof(trailer)), SEEK_END) == 0
+          && std::fread(&trailer, sizeof(trailer), 1, fFile) == 1
+          && std::memcmp(trailer.magic, columnar::kTrailerMagic, sizeof(trailer.magic)) == 0;
+  if (valid) {
+    fIndex.resize(trailer.nofChunks);
+    valid = fseeko(fFile, static_cast<off_t>(trailer.indexOffset), SEEK_SET) == 0
+            && std::fread(fIndex.data(), sizeof(columnar::ChunkEntry), fIndex.size(), fFile)
+                 == fIndex.size();
+  }
+
+  if (!valid) {
+    std::fclose(fFile);
+    fFile = nullptr;
+    fIndex.clear();
+    G4ExceptionDescription ed;
+    ed << "Cannot append to " << fFileName
+       << ": not a columnar file with the same columns, or not closed properly.";
+    G4Exception("ColumnarFile::Open()", "B1Columnar002", JustWarning, ed);
+    return false;
+  }
+
+  // New chunks overwrite the old index, which is rewritten on Close()
+  fOffset = trailer.indexOffset;
+  fNofRows = trailer.nofRows;
+  fseeko(fFile, static_cast<off_t>(fOffset), SEEK_SET);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarFile::CommitRows(std::size_t nofRows)
+{
+  fPendingRows += nofRows;
+  if (fPendingRows >= fChunkRows) WriteChunk();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarFile::WriteChunk()
+{
+  if (!fFile || fPendingRows == 0) return;
+
+  static const char padding[8] = {0};
+  columnar::ChunkEntry entry{fOffset, fPendingRows};
+  for (auto& column : fColumns) {
+    std::fwrite(column.data.data(), 1, column.data.size(), fFile);
+    std::uint64_t size = columnar::ColumnBytes(column.desc, fPendingRows);
+    std::fwrite(padding, 1, size - column.data.size(), fFile);
+    fOffset += size;
+    column.data.clear();
+  }
+  fIndex.push_back(entry);
+  fNofRows += fPendingRows;
+  fPendingRows = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarFile::Close()
+{
+  if (!fFile) return;
+
+  WriteChunk();
+
+  columnar::Trailer trailer;
+  trailer.indexOffset = fOffset;
+  trailer.nofChunks = fIndex.size();
+  trailer.nofRows = fNofRows;
+  std::memcpy(trailer.magic, columnar::kTrailerMagic, sizeof(trailer.magic));
+  std::fwrite(fIndex.data(), sizeof(columnar::ChunkEntry), fIndex.size(), fFile);
+  std::fwrite(&trailer, sizeof(trailer), 1, fFile);
+
+  if (std::ferror(fFile)) {
+    G4ExceptionDescription ed;
+    ed << "Write error on " << fFileName << ".";
+    G4Exception("ColumnarFile::Close()", "B1Columnar003", JustWarning, ed);
+  }
+  std::fclose(fFile);
+  fFile = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
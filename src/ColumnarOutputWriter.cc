@@ -0,0 +1,190 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/ColumnarOutputWriter.cc
+/// \brief Implementation of the B1::ColumnarOutputWriter class
+
+#include "ColumnarOutputWriter.hh"
+
+#include "OutputManifest.hh"
+#include "PMTDigi.hh"
+#include "PhotonBuffer.hh"
+
+#include "G4Exception.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+
+#include <algorithm>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ColumnarOutputWriter::ColumnarOutputWriter()
+{
+  using columnar::ColumnType;
+  fPhotons.AddColumn("Energy", ColumnType::kFloat64);
+  fPhotons.AddColumn("Time", ColumnType::kFloat64);
+  fPhotons.AddColumn("PMT", ColumnType::kInt32);
+  fPhotons.AddColumn("EventID", ColumnType::kInt32);
+  fPhotons.AddColumn("TrackID", ColumnType::kInt32);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarOutputWriter::Open(const G4String& fileName, G4bool append)
+{
+  G4String baseName = fileName;
+  fManifestBaseName.clear();
+  if (G4Threading::IsWorkerThread()) {
+    baseName += "_t" + std::to_string(G4Threading::G4GetThreadId());
+    fManifestBaseName = fileName;
+  }
+
+  if (fPhotons.Open(baseName + ".b1col", append) && !fManifestBaseName.empty()) {
+    OutputManifest::Instance().Add(fManifestBaseName + ".manifest", fPhotons.GetFileName());
+  }
+
+  // The waveform columns depend on the number of samples, so the file is
+  // opened with the first waveform
+  fWaveformsFileName = baseName + "_waveforms.b1col";
+  fAppend = append;
+  fNofSamples = 0;
+
+  // asynchronous writing, see AsyncOutput
+  auto asyncOutput = AsyncOutput::Instance();
+  if (asyncOutput && asyncOutput->IsEnabled() && !fChannel) fChannel = asyncOutput->Connect(this);
+  fAsync = asyncOutput && asyncOutput->IsEnabled() && fChannel;
+  if (fAsync) fChannel->monitor = RunMonitor::GetThreadCounters();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarOutputWriter::Close()
+{
+  // the writer threads no longer use the files afterwards
+  if (fAsync) AsyncOutput::Instance()->Flush(*fChannel);
+  fAsync = false;
+
+  fPhotons.Close();
+  fWaveforms.Close();
+  fWaveformsFileName.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarOutputWriter::FillPhotons(G4int eventID, const PhotonBuffer& photons)
+{
+  if (!fPhotons.IsOpen() || photons.Empty()) return;
+
+  if (fAsync) {
+    auto& record = AsyncOutput::Acquire(*fChannel);
+    record.eventID = eventID;
+    record.waveform = false;
+    record.photons = photons;
+    AsyncOutput::Push(*fChannel, record);
+    return;
+  }
+  WritePhotons(eventID, photons);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarOutputWriter::WritePhotons(G4int eventID, const PhotonBuffer& photons)
+{
+  const std::size_t n = photons.Size();
+  const G4double* energies = photons.GetEnergies().data();
+  const G4double* times = photons.GetTimes().data();
+
+  auto energy = fPhotons.Extend<G4double>(kEnergy, n);
+  auto time = fPhotons.Extend<G4double>(kTime, n);
+  for (std::size_t k = 0; k < n; ++k) {
+    energy[k] = energies[k] / eV;
+    time[k] = times[k] / ns;
+  }
+  std::copy_n(photons.GetPMTIDs().data(), n, fPhotons.Extend<G4int>(kPMT, n));
+  std::fill_n(fPhotons.Extend<G4int>(kEventID, n), n, eventID);
+  std::copy_n(photons.GetTrackIDs().data(), n, fPhotons.Extend<G4int>(kTrackID, n));
+  fPhotons.CommitRows(n);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarOutputWriter::FillWaveform(G4int eventID, const PMTDigi& digi)
+{
+  if (fAsync) {
+    auto& record = AsyncOutput::Acquire(*fChannel);
+    record.eventID = eventID;
+    record.waveform = true;
+    record.digi = digi;
+    AsyncOutput::Push(*fChannel, record);
+    return;
+  }
+  WriteWaveform(eventID, digi);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnarOutputWriter::WriteWaveform(G4int eventID, const PMTDigi& digi)
+{
+  const auto& samples = digi.GetSamples();
+  if (fNofSamples == 0 && !fWaveformsFileName.empty()) {
+    using columnar::ColumnType;
+    fNofSamples = samples.size();
+    fWaveforms.ClearColumns();
+    fWaveforms.AddColumn("EventID", ColumnType::kInt32);
+    fWaveforms.AddColumn("PMT", ColumnType::kInt32);
+    fWaveforms.AddColumn("Charge", ColumnType::kFloat64);
+    fWaveforms.AddColumn("Samples", ColumnType::kFloat32, static_cast<G4int>(fNofSamples));
+    // chunks of about 8 MB
+    std::size_t rowSize = fNofSamples * sizeof(G4float) + 16;
+    fWaveforms.SetChunkRows(std::max<std::size_t>(1, (8 << 20) / rowSize));
+    if (fWaveforms.Open(fWaveformsFileName, fAppend) && !fManifestBaseName.empty()) {
+      OutputManifest::Instance().Add(fManifestBaseName + "_waveforms.manifest",
+                                     fWaveformsFileName);
+    }
+  }
+  if (!fWaveforms.IsOpen()) return;
+
+  if (samples.size() != fNofSamples) {
+    G4ExceptionDescription ed;
+    ed << "Waveform with " << samples.size() << " samples, the file "
+       << fWaveformsFileName << " has " << fNofSamples << ". Waveform not written.";
+    G4Exception("ColumnarOutputWriter::FillWaveform()", "B1Columnar004", JustWarning, ed);
+    return;
+  }
+
+  *fWaveforms.Extend<G4int>(kWaveformEventID, 1) = eventID;
+  *fWaveforms.Extend<G4int>(kWaveformPMT, 1) = digi.GetPMTID();
+  *fWaveforms.Extend<G4double>(kCharge, 1) = digi.GetCharge();
+  std::copy(samples.begin(), samples.end(), fWaveforms.Extend<G4float>(kSamples, 1));
+  fWaveforms.CommitRows(1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -1,6 +1,19 @@
 // DetectorConstruction.cc  — реализация Construct() под ТЗ (исправленная версия)
 #include "DetectorConstruction.hh"
-
+#include "OpticalSpectra.hh"
+#include "PMTSD.hh"
+#include "PhotonMapModel.hh"
+
+#include "SpectralDataLoader.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4GeometryManager.hh"
+#include "G4LogicalBorderSurface.hh"
+#include "G4SolidStore.hh"
+#include "G4StateManager.hh"
+#include "G4SurfaceProperty.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
 #include "G4RunManager.hh"
 #include "G4NistManager.hh"
 #include "G4Box.hh"
@@ -15,187 +28,397 @@
 #include "G4LogicalSkinSurface.hh"
 #include "G4OpticalSurface.hh"
 #include "G4MaterialPropertiesTable.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4SDManager.hh"
+
+#ifdef B1_USE_GDML
+#include "G4GDMLParser.hh"
+#endif
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <vector>
-#include <algorithm>
-#include <iostream>
-#include <string>
 
 namespace B1
 {
 DetectorConstruction::DetectorConstruction()
  : G4VUserDetectorConstruction(),
    fScoringVolume(nullptr),
-   fNumPMTperPlane(12),
-   fPMTRadius(480.*mm),      // радиус размещения ФЭУ (по умолчанию 480 mm)
-   fPMTzOffset( (700.*mm)/2 - 60.*mm ) // расстояние от центра до плоскости верх/ниж ФЭУ (пример)
+   fPMTArray(std::make_unique<PMTArrayBuilder>()),
+   fRegions(std::make_unique<DetectorRegions>())
 {
+  fPMTArray->SetPMTRadius(fPMTCathodeRadius);
+  DefineCommands();
 }
 
-DetectorConstruction::~DetectorConstruction()
+DetectorConstruction::~DetectorConstruction() = default;
+
+// ---- Spectra data files ----------------------------------------------------------
+void DetectorConstruction::SetEmissionFile(G4String fileName)
 {
+  OpticalSpectra::SetEmissionFile(fileName);
+}
+
+void DetectorConstruction::SetSpectraCacheDirectory(G4String directory)
+{
+  OpticalSpectra::SetCacheDirectory(directory);
+}
+
+void DetectorConstruction::DefineCommands()
+{
+  fDetMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/det/", "Detector construction");
+
+  fDetMessenger->DeclareProperty("gdmlCache", fGDMLCache)
+    .SetGuidance("GDML geometry cache. Production jobs read the geometry from it,")
+    .SetGuidance("without overlap checks, if its checksum matches the construction")
+    .SetGuidance("parameters (kept in <fileName>.checksum); it is written by")
+    .SetGuidance("/B1/det/validate. Empty: no cache.")
+    .SetParameterName("fileName", true)
+    .SetDefaultValue("")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  fDetMessenger->DeclareProperty("validate", fValidate)
+    .SetGuidance("Validation mode: build the geometry from the code, check all the")
+    .SetGuidance("placements for overlaps and, if there is none, write the GDML cache.")
+    .SetParameterName("validate", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  fDetMessenger->DeclareProperty("checkOverlaps", fCheckOverlaps)
+    .SetGuidance("Check the overlaps of every placement when it is created.")
+    .SetParameterName("check", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  // Geometry parameters: set between runs, they rebuild the geometry at
+  // the next run (see SetParameter)
+  struct LengthCommand
+  {
+      const char* name;
+      void (DetectorConstruction::*setter)(G4double);
+      const char* guidance;
+  };
+  const LengthCommand lengthCommands[] = {
+    {"tankRadius", &DetectorConstruction::SetTankRadius, "Inner radius of the steel tank."},
+    {"tankThickness", &DetectorConstruction::SetTankThickness, "Thickness of the steel tank."},
+    {"tankHalfHeight", &DetectorConstruction::SetTankHalfHeight, "Half-height of the steel tank."},
+    {"vesselRadius", &DetectorConstruction::SetVesselRadius, "Outer radius of the PMMA vessel."},
+    {"vesselThickness", &DetectorConstruction::SetVesselThickness,
+     "Thickness of the PMMA vessel walls and end caps."},
+    {"vesselHalfHeight", &DetectorConstruction::SetVesselHalfHeight,
+     "Outer half-height of the PMMA vessel."},
+    {"pmtRadius", &DetectorConstruction::SetPMTRadius,
+     "Radius of the default PMT rings (see /B1/det/pmt/)."},
+    {"pmtZOffset", &DetectorConstruction::SetPMTzOffset,
+     "Distance of the default PMT rings to the centre plane."},
+    {"pmtCathodeRadius", &DetectorConstruction::SetPMTCathodeRadius,
+     "Radius of the PMT disc."},
+    {"pmtHalfThickness", &DetectorConstruction::SetPMTHalfThickness,
+     "Half-thickness of the PMT disc."}};
+  for (const auto& command : lengthCommands) {
+    fDetMessenger->DeclareMethodWithUnit(command.name, "mm", command.setter)
+      .SetGuidance(command.guidance)
+      .SetGuidance("Changed between runs, the geometry is rebuilt at the next run.")
+      .SetParameterName("value", false)
+      .SetRange("value>0.")
+      .SetStates(G4State_PreInit, G4State_Idle)
+      .SetToBeBroadcasted(false);
+  }
+
+  fDetMessenger->DeclareMethod("pmtPerPlane", &DetectorConstruction::SetNumPMTperPlane)
+    .SetGuidance("Number of PMTs in each default PMT ring.")
+    .SetGuidance("Changed between runs, the geometry is rebuilt at the next run.")
+    .SetParameterName("nofPMTs", false)
+    .SetRange("nofPMTs>0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/spectra/",
+                                                    "Optical spectra data files");
+
+  // read once per process, at the first /run/initialize
+  fMessenger->DeclareMethod("emissionFile", &DetectorConstruction::SetEmissionFile)
+    .SetGuidance("Bi-MSB emission spectrum file: (wavelength [nm], intensity) lines.")
+    .SetGuidance("~ and $VAR are expanded. Must be set before /run/initialize.")
+    .SetParameterName("fileName", false)
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("cacheDir", &DetectorConstruction::SetSpectraCacheDirectory)
+    .SetGuidance("Directory of the parsed spectra cache (default: $B1_CACHE_DIR,")
+    .SetGuidance("$XDG_CACHE_HOME/exampleB1 or ~/.cache/exampleB1).")
+    .SetParameterName("directory", false)
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
 }
 
 // ---- Construct() ----------------------------------------------------------------
 G4VPhysicalVolume* DetectorConstruction::Construct()
 {
-  // -----------------------
-  // 0) Загрузка спектра Bi-MSB из файла
-  //    (будет применён только к LAB_Gd)
-  // -----------------------
-  const std::string bisFile = "~/bisMSB_EmissionSpectra.dat";
-  std::vector<G4double> filePhotonEnergies; // энергии (eV) — from file
-  std::vector<G4double> fileEmission;       // относительная интенсивность
-
-  std::ifstream fin(bisFile.c_str());
-  if (!fin.is_open()) {
-      G4cerr << "WARNING: cannot open Bi-MSB file: " << bisFile << G4endl;
-      G4cerr << "Using fallback simple two-point emission spectrum." << G4endl;
-      filePhotonEnergies.push_back(2.0*eV);
-      fileEmission.push_back(0.0);
-      filePhotonEnergies.push_back(3.5*eV);
-      fileEmission.push_back(1.0);
-  } else {
-      double lambda_nm=0.0, intensity=0.0;
-      while (fin >> lambda_nm >> intensity) {
-          if (lambda_nm <= 0.0) continue;
-          G4double energy = (1240.0 / lambda_nm) * eV; // convert nm -> eV
-          filePhotonEnergies.push_back(energy);
-          fileEmission.push_back((G4double) intensity);
-      }
-      fin.close();
+  // the previous geometry, at a reinitialisation between runs
+  CleanGeometry();
+
+  // default PMT array: top then bottom ring, copy numbers ring * n + index
+  fPMTArray->SetDefaultLayout(fPMTzOffset, fPMTRadius, fNumPMTperPlane);
+
+  // Production jobs load the validated geometry from the GDML cache; it is
+  // built from the code if the cache is missing or stale, and in validation mode.
+  // The cache is read at the first construction only: the materials it
+  // defines are then reused by the rebuilds of a parameter scan.
+  G4VPhysicalVolume* world = nullptr;
+  if (fFirstConstruction && !fValidate && !fGDMLCache.empty()) world = ReadGeometry();
+  if (!world) {
+    world = BuildGeometry();
+    if (fValidate && ValidateGeometry() && !fGDMLCache.empty()) WriteGeometry(world);
   }
+  fFirstConstruction = false;
+  // navigation tuning of the PMT envelopes, in both cases
+  fPMTArray->Tune();
+
+  // Volumes used at run time, found by name in both cases
+  auto lvStore = G4LogicalVolumeStore::GetInstance();
+  G4LogicalVolume* logicGdLAB = lvStore->GetVolume("GdLAB");
+  fPMTVolume = lvStore->GetVolume("PMT");
+  fScoringVolume = logicGdLAB;
+  auto solidGdLAB = static_cast<const G4Tubs*>(logicGdLAB->GetSolid());
+  fTargetRadius = solidGdLAB->GetOuterRadius();
+  fTargetHalfLength = solidGdLAB->GetZHalfLength();
 
-  std::vector<size_t> idx(filePhotonEnergies.size());
-  for (size_t i=0;i<idx.size();++i) idx[i]=i;
-  std::sort(idx.begin(), idx.end(), [&](size_t a, size_t b){ return filePhotonEnergies[a] < filePhotonEnergies[b]; });
+  // Regions with their cuts and limits; Target is also the envelope of the
+  // parametrised optical model (PhotonMapModel)
+  fRegions->Attach();
 
-  std::vector<G4double> sortedE, sortedI;
-  sortedE.reserve(idx.size());
-  sortedI.reserve(idx.size());
-  for (size_t k=0;k<idx.size();++k){
-      sortedE.push_back(filePhotonEnergies[idx[k]]);
-      sortedI.push_back(fileEmission[idx[k]]);
+  return world;
+}
+
+// ---- Геометрические параметры и перестройка ------------------------------------
+void DetectorConstruction::SetParameter(G4double& parameter, G4double value)
+{
+  parameter = value;
+  // between runs: the geometry is rebuilt at the next run, the physics
+  // tables are kept (only the new material-cuts couples are computed)
+  if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle) {
+    G4RunManager::GetRunManager()->ReinitializeGeometry();
   }
+}
 
-  // Нормировка интенсивности (максимум -> 1.0)
-  G4double maxI = 0.0;
-  for (auto v : sortedI) if (v > maxI) maxI = v;
-  if (maxI <= 0.0) {
-      // если всё нули — заменить на плоский спектр
-      sortedI.assign(sortedI.size(), 1.0);
-      maxI = 1.0;
+void DetectorConstruction::SetNumPMTperPlane(G4int value)
+{
+  fNumPMTperPlane = value;
+  if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle) {
+    G4RunManager::GetRunManager()->ReinitializeGeometry();
   }
-  for (size_t i=0;i<sortedI.size();++i) sortedI[i] = sortedI[i] / maxI;
+}
 
-  const G4int nSpecPoints = static_cast<G4int>(sortedE.size());
-  std::vector<G4double> labGdEnergies = sortedE;
-  std::vector<G4double> labGdEmis     = sortedI;
+void DetectorConstruction::SetPMTCathodeRadius(G4double value)
+{
+  SetParameter(fPMTCathodeRadius, value);
+  fPMTArray->SetPMTRadius(value);
+}
 
-  // -----------------------
-  // 1) Get nist manager and materials
-  // -----------------------
-  G4NistManager* nist = G4NistManager::Instance();
-  G4bool checkOverlaps = true;
+void DetectorConstruction::CleanGeometry()
+{
+  if (!fScoringVolume) return;
 
-  // Air (world)
-  G4Material* air = nist->FindOrBuildMaterial("G4_AIR");
+  // the regions are kept with their settings and fast simulation model,
+  // without the old volumes
+  fRegions->Detach();
+  fScoringVolume = nullptr;
+  fPMTVolume = nullptr;
 
-  // Steel
-  G4Material* steel = nist->FindOrBuildMaterial("G4_STAINLESS-STEEL");
+  ClearGeometryStores();
+}
 
-  // PMMA
-  G4Material* PMMA = nist->FindOrBuildMaterial("G4_PLEXIGLASS");
+void DetectorConstruction::ClearGeometryStores()
+{
+  // volumes and skin surfaces; materials and optical surfaces are kept
+  G4GeometryManager::GetInstance()->OpenGeometry();
+  G4PhysicalVolumeStore::GetInstance()->Clean();
+  G4LogicalVolumeStore::GetInstance()->Clean();
+  G4SolidStore::GetInstance()->Clean();
+  G4LogicalSkinSurface::CleanSurfaceTable();
+  G4LogicalBorderSurface::CleanSurfaceTable();
+}
 
-  // Si for PMT simplification
-  G4Material* silicon = nist->FindOrBuildMaterial("G4_Si");
+// ---- Оптические параметры -------------------------------------------------------
+namespace {
+// Scale the property vector so that its maximum is value
+G4bool SetMaximum(G4MaterialPropertiesTable* mpt, const G4String& key, G4double value)
+{
+  G4MaterialPropertyVector* property = mpt ? mpt->GetProperty(key) : nullptr;
+  if (!property) return false;
+  G4double maximum = 0.;
+  for (std::size_t i = 0; i < property->GetVectorLength(); ++i) {
+    maximum = std::max(maximum, (*property)[i]);
+  }
+  if (maximum <= 0.) return false;
+  property->ScaleVector(1., value / maximum);
+  return true;
+}
 
-  // Create LAB_pure
-  G4Element* elH = nist->FindOrBuildElement("H");
-  G4Element* elC = nist->FindOrBuildElement("C");
-  G4double densityLAB = 0.853*g/cm3;
-  G4Material* LAB_pure = new G4Material("LAB_pure", densityLAB, 2);
-  LAB_pure->AddElement(elC, 17);
-  LAB_pure->AddElement(elH, 27);
+void PropertyNotFound(const G4String& key, const G4String& owner)
+{
+  G4ExceptionDescription ed;
+  ed << "No " << key << " property for " << owner << "; not changed.";
+  G4Exception("DetectorConstruction::SetMaximum()", "B1Optics001", JustWarning, ed);
+}
 
-  // Gd-loaded LAB (1 g/L)
-  G4Element* elGd = nist->FindOrBuildElement("Gd");
-  G4double densityLAB_Gd = 0.86086*g/cm3;
-  G4Material* LAB_Gd = new G4Material("LAB_Gd", densityLAB_Gd, 2);
-  LAB_Gd->AddMaterial(LAB_pure, 99.884*perCent);
-  LAB_Gd->AddElement(elGd, 0.116*perCent);
+G4MaterialPropertiesTable* GetMaterialMPT(const G4String& name)
+{
+  G4Material* material = G4Material::GetMaterial(name, false);
+  return material ? material->GetMaterialPropertiesTable() : nullptr;
+}
+}
 
-  // -----------------------
-  // 2) Оптичесные свойства для "базовых" материалов (fixed spectrum)
-  // -----------------------
-  const G4int nSpec = 8;
-  G4double specEnergies[nSpec] = {
-    2.00*eV, 2.25*eV, 2.50*eV, 2.75*eV, 3.00*eV, 3.25*eV, 3.40*eV, 3.50*eV
-  };
+void DetectorConstruction::SetAbsLengthGd(G4double value)
+{
+  if (!SetMaximum(GetMaterialMPT("LAB_Gd"), "ABSLENGTH", value)) PropertyNotFound("ABSLENGTH", "LAB_Gd");
+}
 
-  // rindex arrays
-  G4double rindex_LAB[nSpec];
-  G4double rindex_PMMA[nSpec];
-  for (G4int i=0;i<nSpec;i++){
-    rindex_LAB[i]  = 1.48;
-    rindex_PMMA[i] = 1.49;
-  }
+void DetectorConstruction::SetAbsLengthLAB(G4double value)
+{
+  if (!SetMaximum(GetMaterialMPT("LAB_pure"), "ABSLENGTH", value)) PropertyNotFound("ABSLENGTH", "LAB_pure");
+}
 
-  // ABS lengths according to TЗ
-  G4double abs_LAB_Gd[nSpec];
-  G4double abs_LAB_pure[nSpec];
-  for (G4int i=0;i<nSpec;i++){
-    abs_LAB_Gd[i]   = 6.*m;   // Gd-LAB = 6 m
-    abs_LAB_pure[i] = 12.*m;  // pure LAB = 12 m
-  }
+void DetectorConstruction::SetMylarReflectivity(G4double value)
+{
+  G4OpticalSurface* surface = FindSurface("Steel_Mylar_Surface");
+  G4MaterialPropertiesTable* mpt = surface ? surface->GetMaterialPropertiesTable() : nullptr;
+  if (!SetMaximum(mpt, "REFLECTIVITY", value)) PropertyNotFound("REFLECTIVITY", "Steel_Mylar_Surface");
+}
+
+void DetectorConstruction::SetPhotocathodeQE(G4double value)
+{
+  // PMTSD and StackingAction sample the OpticalSpectra table with this scale
+  const std::vector<G4double>& qe = OpticalSpectra::Instance().GetQE().GetValues();
+  OpticalSpectra::SetQEScale(value / *std::max_element(qe.begin(), qe.end()));
 
-  G4double abs_PMMA[nSpec];
-  for (G4int i=0;i<nSpec;i++) abs_PMMA[i] = 5.*m;
+  // reference copy in the photocathode surface
+  G4OpticalSurface* surface = FindSurface("PMT_Cath_Surface");
+  if (surface) SetMaximum(surface->GetMaterialPropertiesTable(), "QE", value);
+}
 
-  // PMMA MPT
-  G4MaterialPropertiesTable* mptPMMA = new G4MaterialPropertiesTable();
-  mptPMMA->AddProperty("RINDEX", specEnergies, rindex_PMMA, nSpec);
-  mptPMMA->AddProperty("ABSLENGTH", specEnergies, abs_PMMA, nSpec);
-  PMMA->SetMaterialPropertiesTable(mptPMMA);
+void DetectorConstruction::SetScintillationYield(G4double value)
+{
+  G4MaterialPropertiesTable* mpt = GetMaterialMPT("LAB_Gd");
+  if (!mpt || !mpt->ConstPropertyExists("SCINTILLATIONYIELD")) {
+    PropertyNotFound("SCINTILLATIONYIELD", "LAB_Gd");
+    return;
+  }
+  mpt->AddConstProperty("SCINTILLATIONYIELD", value);
+}
 
-  // LAB_pure MPT (no scintillation)
-  G4MaterialPropertiesTable* mptLABpure = new G4MaterialPropertiesTable();
-  mptLABpure->AddProperty("RINDEX", specEnergies, rindex_LAB, nSpec);
-  mptLABpure->AddProperty("ABSLENGTH", specEnergies, abs_LAB_pure, nSpec);
-  LAB_pure->SetMaterialPropertiesTable(mptLABpure);
+// ---- DefineMaterials() ----------------------------------------------------------
+void DetectorConstruction::DefineMaterials()
+{
+  // Materials and their property tables are built once: found by name at
+  // the following constructions, including those read from the GDML cache
+  G4NistManager* nist = G4NistManager::Instance();
+  fAir = nist->FindOrBuildMaterial("G4_AIR");
+  fSteel = nist->FindOrBuildMaterial("G4_STAINLESS-STEEL");
+  fSilicon = nist->FindOrBuildMaterial("G4_Si");   // Si for PMT simplification
+  fPMMA = nist->FindOrBuildMaterial("G4_PLEXIGLASS");
+  fLABPure = G4Material::GetMaterial("LAB_pure", false);
+  fLABGd = G4Material::GetMaterial("LAB_Gd", false);
 
   // -----------------------
-  // 3) LAB_Gd MPT
+  // Optical spectra (RINDEX, ABSLENGTH, Bi-MSB emission, reflectivity, QE),
+  // built once per process on a common uniform energy grid
   // -----------------------
-  G4MaterialPropertiesTable* mptLABGd = new G4MaterialPropertiesTable();
+  const OpticalSpectra& spectra = OpticalSpectra::Instance();
 
-  // RINDEX и ABSLENGTH для LAB_Gd задаём на той же сетке, что и спектр файла:
-  std::vector<G4double> rindex_labgd_vec(nSpecPoints, 1.48);
-  std::vector<G4double> abs_labgd_vec(nSpecPoints, 6.*m);
+  // PMMA MPT
+  if (!fPMMA->GetMaterialPropertiesTable()) {
+    G4MaterialPropertiesTable* mptPMMA = new G4MaterialPropertiesTable();
+    OpticalSpectra::AddProperty(mptPMMA, "RINDEX", spectra.GetRIndexPMMA());
+    OpticalSpectra::AddProperty(mptPMMA, "ABSLENGTH", spectra.GetAbsLengthPMMA());
+    fPMMA->SetMaterialPropertiesTable(mptPMMA);
+  }
 
-  mptLABGd->AddProperty("RINDEX", &labGdEnergies[0], &rindex_labgd_vec[0], nSpecPoints);
-  mptLABGd->AddProperty("ABSLENGTH", &labGdEnergies[0], &abs_labgd_vec[0], nSpecPoints);
+  // PMT window material MPT
+  if (!fSilicon->GetMaterialPropertiesTable()) {
+    G4MaterialPropertiesTable* mptPMT = new G4MaterialPropertiesTable();
+    OpticalSpectra::AddProperty(mptPMT, "RINDEX", spectra.GetRIndexPMT());
+    OpticalSpectra::AddProperty(mptPMT, "ABSLENGTH", spectra.GetAbsLengthPMT());
+    fSilicon->SetMaterialPropertiesTable(mptPMT);
+  }
 
-  // FASTCOMPONENT = спектр Bi-MSB (normalized)
-  mptLABGd->AddProperty("FASTCOMPONENT", &labGdEnergies[0], &labGdEmis[0], nSpecPoints, true);
-  mptLABGd->AddProperty("SLOWCOMPONENT", &labGdEnergies[0], &labGdEmis[0], nSpecPoints, true);
+  // Create LAB_pure (no scintillation)
+  if (!fLABPure) {
+    G4Element* elH = nist->FindOrBuildElement("H");
+    G4Element* elC = nist->FindOrBuildElement("C");
+    G4double densityLAB = 0.853*g/cm3;
+    fLABPure = new G4Material("LAB_pure", densityLAB, 2);
+    fLABPure->AddElement(elC, 17);
+    fLABPure->AddElement(elH, 27);
+
+    G4MaterialPropertiesTable* mptLABpure = new G4MaterialPropertiesTable();
+    OpticalSpectra::AddProperty(mptLABpure, "RINDEX", spectra.GetRIndexLAB());
+    OpticalSpectra::AddProperty(mptLABpure, "ABSLENGTH", spectra.GetAbsLengthLABPure());
+    fLABPure->SetMaterialPropertiesTable(mptLABpure);
+  }
 
-  // Сцинтилляционные параметры (примерные — можно менять)
-  mptLABGd->AddConstProperty("SCINTILLATIONYIELD", 4300.0/MeV, true);
-  mptLABGd->AddConstProperty("RESOLUTIONSCALE", 1.0, true);
-  mptLABGd->AddConstProperty("FASTTIMECONSTANT", 5.0*ns, true);
-  mptLABGd->AddConstProperty("YIELDRATIO", 1.0, true);
+  // Gd-loaded LAB (1 g/L)
+  if (!fLABGd) {
+    G4Element* elGd = nist->FindOrBuildElement("Gd");
+    G4double densityLAB_Gd = 0.86086*g/cm3;
+    fLABGd = new G4Material("LAB_Gd", densityLAB_Gd, 2);
+    fLABGd->AddMaterial(fLABPure, 99.884*perCent);
+    fLABGd->AddElement(elGd, 0.116*perCent);
+
+    G4MaterialPropertiesTable* mptLABGd = new G4MaterialPropertiesTable();
+    OpticalSpectra::AddProperty(mptLABGd, "RINDEX", spectra.GetRIndexLAB());
+    OpticalSpectra::AddProperty(mptLABGd, "ABSLENGTH", spectra.GetAbsLengthLABGd());
+
+    // FASTCOMPONENT = спектр Bi-MSB (normalized)
+    OpticalSpectra::AddProperty(mptLABGd, "FASTCOMPONENT", spectra.GetBisMSBEmission(), true);
+    OpticalSpectra::AddProperty(mptLABGd, "SLOWCOMPONENT", spectra.GetBisMSBEmission(), true);
+
+    // Сцинтилляционные параметры (примерные — можно менять)
+    mptLABGd->AddConstProperty("SCINTILLATIONYIELD", 4300.0/MeV, true);
+    mptLABGd->AddConstProperty("RESOLUTIONSCALE", 1.0, true);
+    mptLABGd->AddConstProperty("FASTTIMECONSTANT", 5.0*ns, true);
+    mptLABGd->AddConstProperty("YIELDRATIO", 1.0, true);
+
+    fLABGd->SetMaterialPropertiesTable(mptLABGd);
+  }
+}
+
+G4OpticalSurface* DetectorConstruction::FindSurface(const G4String& name)
+{
+  for (auto surface : *G4SurfaceProperty::GetSurfacePropertyTable()) {
+    if (surface->GetName() == name) return dynamic_cast<G4OpticalSurface*>(surface);
+  }
+  return nullptr;
+}
+
+// ---- BuildGeometry() ------------------------------------------------------------
+G4VPhysicalVolume* DetectorConstruction::BuildGeometry()
+{
+  // -----------------------
+  // 0) Materials with their optical properties
+  // -----------------------
+  DefineMaterials();
+  const OpticalSpectra& spectra = OpticalSpectra::Instance();
+  const std::vector<G4double>& specEnergies = spectra.GetEnergies();
+  const std::size_t nSpec = specEnergies.size();
 
-  LAB_Gd->SetMaterialPropertiesTable(mptLABGd);
+  // overlaps are checked once, in validation mode (ValidateGeometry)
+  G4bool checkOverlaps = fCheckOverlaps;
 
   // -----------------------
-  // 4) Геометрия: World
+  // 4) Геометрия: World (с запасом вокруг бака)
   // -----------------------
-  G4double world_size = 2.0*m;
-  G4Box* solidWorld = new G4Box("World", 0.5*world_size, 0.5*world_size, 0.5*world_size);
-  G4LogicalVolume* logicWorld = new G4LogicalVolume(solidWorld, air, "World");
+  G4double steelOuterRadius = fTankRadius + fTankThickness;
+  G4double worldHalfSize = std::max(steelOuterRadius, fTankHalfHeight) + 350.*mm;
+  G4Box* solidWorld = new G4Box("World", worldHalfSize, worldHalfSize, worldHalfSize);
+  G4LogicalVolume* logicWorld = new G4LogicalVolume(solidWorld, fAir, "World");
   G4VPhysicalVolume* physWorld = new G4PVPlacement(nullptr, G4ThreeVector(), logicWorld, "World", nullptr, false, 0, checkOverlaps);
 
   G4VisAttributes* visWorld = new G4VisAttributes(G4Colour(0.8,0.8,0.8,0.05));
@@ -205,18 +428,13 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // -----------------------
   // 5) Стальной бак (shell) и внутренний volume LAB (lab buffer)
   // -----------------------
-  G4double steelInnerRadius = 1260.*mm/2.0;    // 630 mm
-  G4double steelThickness   = 2.*mm;
-  G4double steelOuterRadius = steelInnerRadius + steelThickness;
-  G4double steelHalfHeight  = 1300.*mm/2.0;    // half-length
-
   // Steel shell (only the steel)
-  G4Tubs* solidSteelTank = new G4Tubs("SteelTank", steelInnerRadius, steelOuterRadius, steelHalfHeight, 0.*deg, 360.*deg);
-  G4LogicalVolume* logicSteelTank = new G4LogicalVolume(solidSteelTank, steel, "SteelTank");
+  G4Tubs* solidSteelTank = new G4Tubs("SteelTank", fTankRadius, steelOuterRadius, fTankHalfHeight, 0.*deg, 360.*deg);
+  G4LogicalVolume* logicSteelTank = new G4LogicalVolume(solidSteelTank, fSteel, "SteelTank");
   new G4PVPlacement(nullptr, G4ThreeVector(), logicSteelTank, "SteelTank", logicWorld, false, 0, checkOverlaps);
 
-  G4Tubs* solidLabBuffer = new G4Tubs("LabBuffer", 0.*mm, steelInnerRadius, steelHalfHeight, 0.*deg, 360.*deg);
-  G4LogicalVolume* logicLabBuffer = new G4LogicalVolume(solidLabBuffer, LAB_pure, "LabBuffer");
+  G4Tubs* solidLabBuffer = new G4Tubs("LabBuffer", 0.*mm, fTankRadius, fTankHalfHeight, 0.*deg, 360.*deg);
+  G4LogicalVolume* logicLabBuffer = new G4LogicalVolume(solidLabBuffer, fLABPure, "LabBuffer");
   new G4PVPlacement(nullptr, G4ThreeVector(), logicLabBuffer, "LabBuffer", logicWorld, false, 0, checkOverlaps);
 
   // визуализация
@@ -231,20 +449,17 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // -----------------------
   // 6) PMMA vessel and Gd-LAB inside it
   // -----------------------
-  G4double vesselOuterRadius = 1200.*mm / 2.0; // 600 mm
-  G4double pmmaThickness = 10.*mm;
-  G4double vesselInnerRadius = vesselOuterRadius - pmmaThickness; // 590 mm
-  G4double vesselHalfHeight = 700.*mm / 2.0; // half-length
-
-  // PMMA shell
-  G4Tubs* solidPMMAvessel = new G4Tubs("PMMAVessel", vesselInnerRadius, vesselOuterRadius, vesselHalfHeight, 0.*deg, 360.*deg);
-  G4LogicalVolume* logicPMMAvessel = new G4LogicalVolume(solidPMMAvessel, PMMA, "PMMAVessel");
+  G4double vesselInnerRadius = fVesselRadius - fVesselThickness;
+
+  // PMMA vessel: full cylinder, Gd-LAB is its daughter (barrel and end caps of fVesselThickness)
+  G4Tubs* solidPMMAvessel = new G4Tubs("PMMAVessel", 0.*mm, fVesselRadius, fVesselHalfHeight, 0.*deg, 360.*deg);
+  G4LogicalVolume* logicPMMAvessel = new G4LogicalVolume(solidPMMAvessel, fPMMA, "PMMAVessel");
   // PMMA vessel размещаем внутри LabBuffer
   new G4PVPlacement(nullptr, G4ThreeVector(), logicPMMAvessel, "PMMAVessel", logicLabBuffer, false, 0, checkOverlaps);
 
   // Gd-LAB inside PMMA
-  G4Tubs* solidGdLAB = new G4Tubs("GdLAB", 0.*mm, vesselInnerRadius, vesselHalfHeight, 0.*deg, 360.*deg);
-  G4LogicalVolume* logicGdLAB = new G4LogicalVolume(solidGdLAB, LAB_Gd, "GdLAB");
+  G4Tubs* solidGdLAB = new G4Tubs("GdLAB", 0.*mm, vesselInnerRadius, fVesselHalfHeight - fVesselThickness, 0.*deg, 360.*deg);
+  G4LogicalVolume* logicGdLAB = new G4LogicalVolume(solidGdLAB, fLABGd, "GdLAB");
   new G4PVPlacement(nullptr, G4ThreeVector(), logicGdLAB, "GdLAB", logicPMMAvessel, false, 0, checkOverlaps);
 
   // Visualization
@@ -256,97 +471,246 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   visGdLab->SetForceSolid(true);
   logicGdLAB->SetVisAttributes(visGdLab);
 
-  fScoringVolume = logicGdLAB;
-
   // -----------------------
-  // 7) Optical surfaces
+  // 7) Optical surfaces (created once, the skin surfaces at every construction)
   //    7.2 Steel inner surface — Mylar (reflectivity 0.9)
   // -----------------------
   // 7.1 PMMA - Gd interface
-  G4OpticalSurface* surfPMMA_Gd = new G4OpticalSurface("PMMA_Gd_Surface");
-  surfPMMA_Gd->SetType(dielectric_dielectric);
-  surfPMMA_Gd->SetFinish(polished);
-  surfPMMA_Gd->SetModel(unified);
-
-  G4MaterialPropertiesTable* mptSurfPMMA = new G4MaterialPropertiesTable();
-  std::vector<G4double> zeroRef(nSpec, 0.0);
-  surfPMMA_Gd->SetMaterialPropertiesTable(mptSurfPMMA);
+  G4OpticalSurface* surfPMMA_Gd = FindSurface("PMMA_Gd_Surface");
+  if (!surfPMMA_Gd) {
+    surfPMMA_Gd = new G4OpticalSurface("PMMA_Gd_Surface");
+    surfPMMA_Gd->SetType(dielectric_dielectric);
+    surfPMMA_Gd->SetFinish(polished);
+    surfPMMA_Gd->SetModel(unified);
+
+    G4MaterialPropertiesTable* mptSurfPMMA = new G4MaterialPropertiesTable();
+    surfPMMA_Gd->SetMaterialPropertiesTable(mptSurfPMMA);
+  }
   new G4LogicalSkinSurface("PMMA_Skin", logicPMMAvessel, surfPMMA_Gd);
 
   // 7.2 Steel inner surface covered with Mylar (dielectric_metal)
-  G4OpticalSurface* surfSteelMylar = new G4OpticalSurface("Steel_Mylar_Surface");
-  surfSteelMylar->SetType(dielectric_metal);
-  surfSteelMylar->SetFinish(polished);
-  surfSteelMylar->SetModel(unified);
-
-  std::vector<G4double> reflMylar(nSpec, 0.90);
-  std::vector<G4double> zeroEff(nSpec, 0.0);
-  G4MaterialPropertiesTable* mptSurfSteel = new G4MaterialPropertiesTable();
-  mptSurfSteel->AddProperty("REFLECTIVITY", specEnergies, &reflMylar[0], nSpec);
-  mptSurfSteel->AddProperty("EFFICIENCY", specEnergies, &zeroEff[0], nSpec);
-  surfSteelMylar->SetMaterialPropertiesTable(mptSurfSteel);
+  G4OpticalSurface* surfSteelMylar = FindSurface("Steel_Mylar_Surface");
+  if (!surfSteelMylar) {
+    surfSteelMylar = new G4OpticalSurface("Steel_Mylar_Surface");
+    surfSteelMylar->SetType(dielectric_metal);
+    surfSteelMylar->SetFinish(polished);
+    surfSteelMylar->SetModel(unified);
+
+    std::vector<G4double> zeroEff(nSpec, 0.0);
+    G4MaterialPropertiesTable* mptSurfSteel = new G4MaterialPropertiesTable();
+    OpticalSpectra::AddProperty(mptSurfSteel, "REFLECTIVITY", spectra.GetMylarReflectivity());
+    mptSurfSteel->AddProperty("EFFICIENCY", specEnergies, zeroEff);
+    surfSteelMylar->SetMaterialPropertiesTable(mptSurfSteel);
+  }
 
   // Apply skin surface to the steel logical volume (inner surface reflection)
   new G4LogicalSkinSurface("SteelInnerMylar", logicSteelTank, surfSteelMylar);
 
   // -----------------------
-  // 8) PMTs: material properties + placement
+  // 8) PMTs: photocathode surface + placement
   // -----------------------
-  // PMT window material MPT (use specEnergies grid)
-  G4double rindex_pmt[nSpec];
-  for (G4int i=0;i<nSpec;i++) rindex_pmt[i] = 1.52;
-  G4double abs_pmt[nSpec];
-  for (G4int i=0;i<nSpec;i++) abs_pmt[i] = 1.*nm;
+  // Logical PMT (simplified short disk)
+  G4Tubs* solidPMT = new G4Tubs("PMT", 0.*mm, fPMTCathodeRadius, fPMTHalfThickness, 0.*deg, 360.*deg);
+  G4LogicalVolume* logicPMT = new G4LogicalVolume(solidPMT, fSilicon, "PMT");
+
+  // Photocathode optical surface: EFFICIENCY = 1 so that every photon absorbed
+  // on the photocathode is handed to PMTSD, which samples spectra.GetQE() itself
+  G4OpticalSurface* surfPMT_cath = FindSurface("PMT_Cath_Surface");
+  if (!surfPMT_cath) {
+    std::vector<G4double> QE(nSpec, 1.0);
+    std::vector<G4double> zeroR(nSpec, 0.0);
+
+    surfPMT_cath = new G4OpticalSurface("PMT_Cath_Surface");
+    surfPMT_cath->SetType(dielectric_metal); // commonly used for photocathode modelling
+    surfPMT_cath->SetModel(unified);
+    surfPMT_cath->SetFinish(polished);
+
+    G4MaterialPropertiesTable* mptSurfPMT = new G4MaterialPropertiesTable();
+    mptSurfPMT->AddProperty("EFFICIENCY", specEnergies, QE);
+    mptSurfPMT->AddProperty("REFLECTIVITY", specEnergies, zeroR);
+    // photocathode QE, for reference (PMTSD samples the same table)
+    OpticalSpectra::AddProperty(mptSurfPMT, "QE", spectra.GetQE(), true);
+    surfPMT_cath->SetMaterialPropertiesTable(mptSurfPMT);
+  }
 
-  G4MaterialPropertiesTable* mptPMT = new G4MaterialPropertiesTable();
-  mptPMT->AddProperty("RINDEX", specEnergies, rindex_pmt, nSpec);
-  mptPMT->AddProperty("ABSLENGTH", specEnergies, abs_pmt, nSpec);
-  silicon->SetMaterialPropertiesTable(mptPMT);
+  // Apply skin surface to logicPMT once (not in loop)
+  new G4LogicalSkinSurface("PMT_Skin", logicPMT, surfPMT_cath);
 
-  // Logical PMT (simplified short disk)
-  G4double pmtRadius = 75.*mm;
-  G4Tubs* solidPMT = new G4Tubs("PMT", 0.*mm, pmtRadius, 2.*mm, 0.*deg, 360.*deg);
-  G4LogicalVolume* logicPMT = new G4LogicalVolume(solidPMT, silicon, "PMT");
+  // Place PMTs (children of LabBuffer so they are in LAB), grouped in
+  // envelopes of LAB_pure as parameterised volumes (see PMTArrayBuilder)
+  fPMTArray->Build(logicPMT, logicLabBuffer, fLABPure, checkOverlaps);
 
-  // Photocathode optical surface: set EFFICIENCY = 0.28 (const) on specEnergies
-  std::vector<G4double> QE(nSpec, 0.28); // 28%
-  std::vector<G4double> zeroR(nSpec, 0.0);
+  // -----------------------
+  // 9) Finish
+  // -----------------------
+  return physWorld;
+}
 
-  G4OpticalSurface* surfPMT_cath = new G4OpticalSurface("PMT_Cath_Surface");
-  surfPMT_cath->SetType(dielectric_metal); // commonly used for photocathode modelling
-  surfPMT_cath->SetModel(unified);
-  surfPMT_cath->SetFinish(polished);
+// ---- Validation and GDML cache --------------------------------------------------
+namespace {
+const char* kChecksumAuxType = "B1GeometryChecksum";
+// the checksum file of the cache <fileName> is <fileName>.checksum
+const char* kChecksumSuffix = ".checksum";
+// increment when BuildGeometry() changes
+const G4int kGeometryVersion = 3;
+}
 
-  G4MaterialPropertiesTable* mptSurfPMT = new G4MaterialPropertiesTable();
-  mptSurfPMT->AddProperty("EFFICIENCY", specEnergies, &QE[0], nSpec);
-  mptSurfPMT->AddProperty("REFLECTIVITY", specEnergies, &zeroR[0], nSpec);
-  surfPMT_cath->SetMaterialPropertiesTable(mptSurfPMT);
+std::uint64_t DetectorConstruction::GetChecksum() const
+{
+  // construction parameters and the spectra the property tables are made of
+  std::vector<G4double> data = {G4double(kGeometryVersion), fTankRadius, fTankThickness,
+                                fTankHalfHeight, fVesselRadius, fVesselThickness,
+                                fVesselHalfHeight, fPMTCathodeRadius, fPMTHalfThickness};
+  std::vector<G4double> pmtArray = fPMTArray->GetParameters();
+  data.insert(data.end(), pmtArray.begin(), pmtArray.end());
+  const OpticalSpectra& spectra = OpticalSpectra::Instance();
+  for (const SpectralTable* table :
+       {&spectra.GetRIndexLAB(), &spectra.GetRIndexPMMA(), &spectra.GetRIndexPMT(),
+        &spectra.GetAbsLengthLABGd(), &spectra.GetAbsLengthLABPure(),
+        &spectra.GetAbsLengthPMMA(), &spectra.GetAbsLengthPMT(), &spectra.GetBisMSBEmission(),
+        &spectra.GetMylarReflectivity(), &spectra.GetQE()})
+  {
+    data.insert(data.end(), table->GetEnergies().begin(), table->GetEnergies().end());
+    data.insert(data.end(), table->GetValues().begin(), table->GetValues().end());
+  }
+  return SpectralDataLoader::Hash(reinterpret_cast<const char*>(data.data()),
+                                  data.size() * sizeof(G4double));
+}
 
-  // Apply skin surface to logicPMT once (not in loop)
-  new G4LogicalSkinSurface("PMT_Skin", logicPMT, surfPMT_cath);
+G4bool DetectorConstruction::ValidateGeometry() const
+{
+  // every placement, including the PMTs, checked once here
+  G4int nofOverlaps = 0;
+  for (auto volume : *G4PhysicalVolumeStore::GetInstance()) {
+    if (volume->CheckOverlaps(1000, 0., false)) ++nofOverlaps;
+  }
+
+  G4cout << " Geometry validation: " << G4PhysicalVolumeStore::GetInstance()->size()
+         << " placements checked, " << nofOverlaps << " with overlaps" << G4endl;
+  if (nofOverlaps > 0) {
+    G4ExceptionDescription ed;
+    ed << nofOverlaps << " placements overlap; the GDML cache is not written.";
+    G4Exception("DetectorConstruction::ValidateGeometry()", "B1Geometry001", JustWarning, ed);
+    return false;
+  }
+  return true;
+}
 
-  // Place PMTs: top and bottom planes (children of LabBuffer so they are in LAB)
-  G4double zTop  = +fPMTzOffset;
-  G4double zBottom = -fPMTzOffset;
-  G4double twoPi = 2.0*M_PI;
+#ifdef B1_USE_GDML
 
-  for (G4int i=0; i < fNumPMTperPlane; ++i) {
-    G4double phi = (twoPi / fNumPMTperPlane) * i;
-    G4double x = fPMTRadius * std::cos(phi);
-    G4double y = fPMTRadius * std::sin(phi);
+G4VPhysicalVolume* DetectorConstruction::ReadGeometry() const
+{
+  // The checksum is kept in a sidecar file, so that a stale cache is
+  // detected before its materials and volumes are created by the parser
+  const G4String checksum = std::to_string(GetChecksum());
+  std::ifstream in(fGDMLCache + kChecksumSuffix);
+  G4String cachedChecksum;
+  if (!in || !(in >> cachedChecksum)) {
+    G4cout << " No geometry cache " << fGDMLCache
+           << ": building the geometry (/B1/det/validate to create it)" << G4endl;
+    return nullptr;
+  }
+  if (cachedChecksum != checksum) {
+    G4ExceptionDescription ed;
+    ed << "The geometry cache " << fGDMLCache << " does not match the construction "
+       << "parameters; building the geometry (/B1/det/validate to update it).";
+    G4Exception("DetectorConstruction::ReadGeometry()", "B1Geometry002", JustWarning, ed);
+    return nullptr;
+  }
 
-    // Top PMT
-    G4ThreeVector posTop(x, y, zTop);
-    new G4PVPlacement(nullptr, posTop, logicPMT, "PMT_top", logicLabBuffer, false, i, checkOverlaps);
+  G4GDMLParser parser;
+  parser.Read(fGDMLCache, false);
 
-    // Bottom PMT
-    G4ThreeVector posBot(x, y, zBottom);
-    new G4PVPlacement(nullptr, posBot, logicPMT, "PMT_bot", logicLabBuffer, false, i + fNumPMTperPlane, checkOverlaps);
+  // the checksum is also in the auxiliary info of the GDML file: it catches
+  // a sidecar left next to another file
+  G4String fileChecksum;
+  if (const auto auxList = parser.GetAuxList()) {
+    for (const auto& aux : *auxList) {
+      if (aux.type == kChecksumAuxType) fileChecksum = aux.value;
+    }
+  }
+  if (fileChecksum != checksum) {
+    G4ExceptionDescription ed;
+    ed << "The geometry cache " << fGDMLCache << " does not match its checksum file "
+       << fGDMLCache + kChecksumSuffix << "; building the geometry.";
+    G4Exception("DetectorConstruction::ReadGeometry()", "B1Geometry005", JustWarning, ed);
+    // the volumes are found by name after the construction: none of the
+    // parsed ones may remain next to those of BuildGeometry()
+    ClearGeometryStores();
+    return nullptr;
   }
 
-  // -----------------------
-  // 9) Finish
-  // -----------------------
-  return physWorld;
+  G4cout << " Geometry read from the cache " << fGDMLCache << G4endl;
+  return parser.GetWorldVolume();
+}
+
+void DetectorConstruction::WriteGeometry(const G4VPhysicalVolume* world) const
+{
+  // the checksum file goes first and is written last: an interrupted write
+  // leaves no valid cache
+  const G4String checksum = std::to_string(GetChecksum());
+  const G4String checksumName = fGDMLCache + kChecksumSuffix;
+  std::remove(checksumName.c_str());
+
+  // the world is exported with its materials, property tables and optical surfaces
+  G4GDMLParser parser;
+  parser.AddAuxiliary({kChecksumAuxType, checksum, "", nullptr});
+  G4String tmpName = fGDMLCache + ".tmp";
+  std::remove(tmpName.c_str());
+  parser.Write(tmpName, world, true);
+  G4bool written = std::rename(tmpName.c_str(), fGDMLCache.c_str()) == 0;
+  if (written) {
+    std::ofstream out(checksumName);
+    out << checksum << std::endl;
+    written = static_cast<G4bool>(out);
+  }
+  if (!written) {
+    G4ExceptionDescription ed;
+    ed << "Cannot write the geometry cache " << fGDMLCache << ".";
+    G4Exception("DetectorConstruction::WriteGeometry()", "B1Geometry003", JustWarning, ed);
+    return;
+  }
+  G4cout << " Geometry cache written to " << fGDMLCache << G4endl;
+}
+
+#else
+
+G4VPhysicalVolume* DetectorConstruction::ReadGeometry() const
+{
+  G4ExceptionDescription ed;
+  ed << "Geant4 is built without GDML: the geometry cache is ignored.";
+  G4Exception("DetectorConstruction::ReadGeometry()", "B1Geometry004", JustWarning, ed);
+  return nullptr;
+}
+
+void DetectorConstruction::WriteGeometry(const G4VPhysicalVolume*) const
+{
+  G4ExceptionDescription ed;
+  ed << "Geant4 is built without GDML: the geometry cache is not written.";
+  G4Exception("DetectorConstruction::WriteGeometry()", "B1Geometry004", JustWarning, ed);
+}
+
+#endif
+
+// ---- ConstructSDandField() ------------------------------------------------------
+void DetectorConstruction::ConstructSDandField()
+{
+  // PMT sensitive detector: one hit per PMT number (0 .. GetNofPMTs()-1).
+  // At a geometry rebuild, the detector and the model of this thread are
+  // kept and attached to the new volumes.
+  auto sdManager = G4SDManager::GetSDMpointer();
+  auto pmtSD = static_cast<PMTSD*>(sdManager->FindSensitiveDetector("/B1/PMT", false));
+  if (pmtSD) {
+    pmtSD->SetNofPMTs(fPMTArray->GetNofPMTs());
+    SetSensitiveDetector(fPMTVolume, pmtSD);
+    return;
+  }
+  pmtSD = new PMTSD("/B1/PMT", "PMTHitsCollection", fPMTArray->GetNofPMTs());
+  sdManager->AddNewDetector(pmtSD);
+  SetSensitiveDetector(fPMTVolume, pmtSD);
+
+  // Parametrised optical model for the photons emitted in the target
+  auto targetRegion = G4RegionStore::GetInstance()->GetRegion("Target");
+  new PhotonMapModel("PhotonMapModel", targetRegion, pmtSD);
 }
 }
\ No newline at end of file
@@ -0,0 +1,289 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/DetectorRegions.cc
+/// \brief Implementation of the B1::DetectorRegions class
+
+#include "DetectorRegions.hh"
+
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4UIcommand.hh"
+#include "G4UnitsTable.hh"
+#include "G4UserLimits.hh"
+
+#include <cfloat>
+#include <sstream>
+
+namespace B1
+{
+
+namespace
+{
+// The optical photons have eV energies: the kinetic energy limit, meant
+// for the other particles, would kill them all
+class RegionLimits : public G4UserLimits
+{
+  public:
+    G4double GetUserMinEkine(const G4Track& track) override
+    {
+      if (track.GetParticleDefinition() == G4OpticalPhoton::Definition()) return 0.;
+      return G4UserLimits::GetUserMinEkine(track);
+    }
+};
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorRegions::DetectorRegions()
+{
+  fRegions = {{"Target", "GdLAB"}, {"Buffer", "LabBuffer"}, {"Shield", "SteelTank"},
+              {"PMT", "PMT"}};
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorRegions::~DetectorRegions() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::Attach()
+{
+  auto lvStore = G4LogicalVolumeStore::GetInstance();
+  for (auto& settings : fRegions) {
+    // the regions are created once, with their cuts, limits and (Target)
+    // fast simulation model, and kept across the geometry rebuilds
+    if (!settings.region) {
+      settings.region = G4RegionStore::GetInstance()->FindOrCreateRegion(settings.name);
+    }
+    settings.root = lvStore->GetVolume(settings.rootName, false);
+    if (!settings.root) {
+      G4ExceptionDescription ed;
+      ed << "No volume " << settings.rootName << " for the region " << settings.name << ".";
+      G4Exception("DetectorRegions::Attach()", "B1Region001", JustWarning, ed);
+      continue;
+    }
+    settings.region->AddRootLogicalVolume(settings.root);
+    Apply(settings);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::Detach()
+{
+  // every region has a single root volume: it is not accessed on removal
+  for (auto& settings : fRegions) {
+    if (settings.region && settings.root) {
+      settings.region->RemoveRootLogicalVolume(settings.root, false);
+    }
+    settings.root = nullptr;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::SetCut(const G4String& region, G4double value)
+{
+  Set(region, &Settings::cut, value);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::SetMaxTime(const G4String& region, G4double value)
+{
+  Set(region, &Settings::maxTime, value);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::SetMinEkin(const G4String& region, G4double value)
+{
+  Set(region, &Settings::minEkin, value);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::Print() const
+{
+  G4cout << " Detector regions:" << G4endl;
+  for (const auto& settings : fRegions) {
+    G4cout << "  " << settings.name << " (" << settings.rootName << "): cut ";
+    if (settings.cut > 0.) {
+      G4cout << G4BestUnit(settings.cut, "Length");
+    }
+    else {
+      G4cout << "default";
+    }
+    if (settings.maxTime > 0.) G4cout << ", max time " << G4BestUnit(settings.maxTime, "Time");
+    if (settings.minEkin > 0.) G4cout << ", min Ekin " << G4BestUnit(settings.minEkin, "Energy");
+    G4cout << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorRegions::Settings* DetectorRegions::Find(const G4String& name)
+{
+  for (auto& settings : fRegions) {
+    if (settings.name == name) return &settings;
+  }
+  G4ExceptionDescription ed;
+  ed << "Unknown region " << name << " (Target, Buffer, Shield or PMT); not changed.";
+  G4Exception("DetectorRegions::Find()", "B1Region002", JustWarning, ed);
+  return nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::Set(const G4String& region, G4double Settings::*value, G4double newValue)
+{
+  Settings* settings = Find(region);
+  if (!settings) return;
+  settings->*value = newValue;
+  // before the first construction, applied by Attach
+  if (settings->region) Apply(*settings);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::Apply(Settings& settings) const
+{
+  // Changed between runs, the modified cuts are picked up by the kernel at
+  // the next run, which recomputes the material-cuts couples
+  if (settings.cut > 0.) {
+    if (!settings.cuts) settings.cuts = new G4ProductionCuts();
+    settings.cuts->SetProductionCut(settings.cut);
+    settings.region->SetProductionCuts(settings.cuts);
+  }
+  else {
+    settings.region->SetProductionCuts(
+      G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts());
+  }
+
+  // the volumes of the region without their own limits use these
+  if (settings.maxTime > 0. || settings.minEkin > 0.) {
+    if (!settings.limits) settings.limits = new RegionLimits();
+    settings.limits->SetUserMaxTime(settings.maxTime > 0. ? settings.maxTime : DBL_MAX);
+    settings.limits->SetUserMinEkine(settings.minEkin);
+    settings.region->SetUserLimits(settings.limits);
+  }
+  else {
+    settings.region->SetUserLimits(nullptr);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::SetCommand(const G4String& parameters, G4double Settings::*value,
+                                 const char* command, const char* defaultUnit)
+{
+  // region value [unit]
+  std::istringstream is(parameters);
+  G4String region;
+  G4double number = 0.;
+  if (!(is >> region >> number) || number < 0.) {
+    G4ExceptionDescription ed;
+    ed << "Bad parameters for " << command << ": \"" << parameters << "\".";
+    G4Exception("DetectorRegions::SetCommand()", "B1Region003", JustWarning, ed);
+    return;
+  }
+  G4String unit = defaultUnit;
+  is >> unit;
+  Set(region, value, number * G4UIcommand::ValueOf(unit.c_str()));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::SetCutCommand(const G4String& parameters)
+{
+  SetCommand(parameters, &Settings::cut, "cut", "mm");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::SetMaxTimeCommand(const G4String& parameters)
+{
+  SetCommand(parameters, &Settings::maxTime, "maxTime", "ns");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::SetMinEkinCommand(const G4String& parameters)
+{
+  SetCommand(parameters, &Settings::minEkin, "minEkin", "MeV");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegions::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/region/",
+                                                    "Detector regions: cuts and limits");
+
+  fMessenger->DeclareMethod("cut", &DetectorRegions::SetCutCommand)
+    .SetGuidance("Production cut of all the secondaries in a region:")
+    .SetGuidance("  region value [unit=mm]; 0 restores the default cuts.")
+    .SetGuidance("Regions: Target, Buffer, Shield, PMT.")
+    .SetParameterName("parameters", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("maxTime", &DetectorRegions::SetMaxTimeCommand)
+    .SetGuidance("Tracks are killed in a region beyond this global time:")
+    .SetGuidance("  region value [unit=ns]; 0 removes the limit.")
+    .SetGuidance("Applies to all the particles, optical photons included.")
+    .SetParameterName("parameters", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("minEkin", &DetectorRegions::SetMinEkinCommand)
+    .SetGuidance("Tracks are killed in a region below this kinetic energy:")
+    .SetGuidance("  region value [unit=MeV]; 0 removes the limit.")
+    .SetGuidance("Applies to all the particles except the optical photons.")
+    .SetParameterName("parameters", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("list", &DetectorRegions::ListCommand)
+    .SetGuidance("Print the regions with their cuts and limits.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
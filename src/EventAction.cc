@@ -1,27 +1,126 @@
 #include "EventAction.hh"
 
+#include "PMTDigi.hh"
+#include "PMTHit.hh"
+#include "PhotonMapGenerator.hh"
 #include "RunAction.hh"
 
+#include "G4DCofThisEvent.hh"
+#include "G4DigiManager.hh"
+#include "G4Event.hh"
+#include "G4GenericMessenger.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SDManager.hh"
+
 namespace B1
 {
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-EventAction::EventAction(RunAction* runAction) : fRunAction(runAction) {}
+EventAction::EventAction(RunAction* runAction) : fRunAction(runAction)
+{
+  DefineCommands();
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EventAction::BeginOfEventAction(const G4Event*)
+EventAction::~EventAction() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::BeginOfEventAction(const G4Event* event)
 {
+  fMonitor = RunMonitor::GetThreadCounters();
+  if (fMonitor) RunMonitor::BeginEvent(fMonitor, event->GetEventID());
+
   fEdep = 0.;
+
+  fTrigger = fRunAction->GetTrigger();
+  if (fTrigger->IsActive()) {
+    fTrigger->BeginEvent();
+  }
+  else {
+    fTrigger = nullptr;
+  }
+
+  if (fPMTHCID < 0) {
+    fPMTHCID = G4SDManager::GetSDMpointer()->GetCollectionID("PMTHitsCollection");
+  }
+
+  fPhotons.Reserve();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EventAction::EndOfEventAction(const G4Event*)
+void EventAction::EndOfEventAction(const G4Event* event)
 {
+  // photon map generation: only count the detected photons of the cell
+  if (PhotonMapGenerator::IsActive()) {
+    const PhotonMapGenerator* generator = PhotonMapGenerator::Instance();
+    fRunAction->FillPhotonMap(generator->GetSliceCell(event->GetEventID()),
+                              generator->GetPhotonsPerEvent(), fPhotons);
+    fPhotons.Clear();
+    if (fMonitor) RunMonitor::EndEvent(fMonitor);
+    return;
+  }
+
+  auto hce = event->GetHCofThisEvent();
+  if (hce) {
+    auto hitsCollection = static_cast<PMTHitsCollection*>(hce->GetHC(fPMTHCID));
+    for (std::size_t i = 0; i < hitsCollection->entries(); ++i) {
+      fEdep += (*hitsCollection)[i]->GetEnergySum();
+    }
+  }
+
+  // digitize the PMT waveforms and write one row per PMT
+  auto digiManager = G4DigiManager::GetDMpointer();
+  if (digiManager->FindDigitizerModule("PMTDigitizer")) {
+    digiManager->Digitize("PMTDigitizer");
+    if (fDigiCollID < 0) {
+      fDigiCollID = digiManager->GetDigiCollectionID("PMTDigitizer/PMTDigitsCollection");
+    }
+    auto dce = event->GetDCofThisEvent();
+    auto digitsCollection =
+      dce ? static_cast<PMTDigitsCollection*>(dce->GetDC(fDigiCollID)) : nullptr;
+    if (digitsCollection) {
+      for (std::size_t i = 0; i < digitsCollection->entries(); ++i) {
+        fRunAction->FillWaveform(event->GetEventID(), *(*digitsCollection)[i]);
+      }
+    }
+  }
+
+  // flush the photon buffer to the output
+  fRunAction->FillPhotons(event->GetEventID(), fPhotons, fWritePhotons);
+  fPhotons.Clear();
+
   // accumulate statistics in run action
   fRunAction->AddEdep(fEdep);
+  if (fTrigger) fTrigger->EndEvent();
+
+  if (fMonitor) RunMonitor::EndEvent(fMonitor);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::FillCullingValidation(G4double energy, G4double time, G4bool reference,
+                                        G4bool culled)
+{
+  fRunAction->FillCullingValidation(energy, time, reference, culled);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/event/", "Event output");
+
+  fMessenger->DeclareProperty("writePhotons", fWritePhotons)
+    .SetGuidance("Write every detected photon to the Photons ntuple or columnar file.")
+    .SetGuidance("The digitized waveforms are written in any case, and the summary")
+    .SetGuidance("format always histograms the photons.")
+    .SetParameterName("write", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
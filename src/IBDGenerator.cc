@@ -0,0 +1,279 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/IBDGenerator.cc
+/// \brief Implementation of the B1::IBDGenerator class
+
+#include "IBDGenerator.hh"
+
+#include "G4Event.hh"
+#include "G4Neutron.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Positron.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace B1
+{
+
+namespace
+{
+const G4double kEMax = 10. * MeV;
+const std::size_t kNofEnergyBins = 1024;
+const std::size_t kNofAngleEnergyBins = 64;
+const std::size_t kNofAnglePoints = 257;
+const std::size_t kNofCosSteps = 1000;
+
+const G4double kDelta = CLHEP::neutron_mass_c2 - CLHEP::proton_mass_c2;
+const G4double kNucleonMass = 0.5 * (CLHEP::neutron_mass_c2 + CLHEP::proton_mass_c2);
+
+// Nucleon couplings f = 1 and g = g_A: asymmetry of the angular
+// distribution, a = (f^2 - g^2) / (f^2 + 3 g^2)
+const G4double kGA = 1.2701;
+const G4double kAsymmetry = (1. - kGA * kGA) / (1. + 3. * kGA * kGA);
+
+// Reactor antineutrino spectra per fission, exp(sum a_k E^k) with E in
+// MeV: Huber 2011 (235U, 239Pu, 241Pu) and Mueller 2011 (238U) fits,
+// with typical fission fractions of a PWR in the middle of a cycle
+struct Isotope
+{
+    G4double fraction;
+    G4double a[6];
+};
+const Isotope kIsotopes[] = {
+  {0.58, {4.367, -4.577, 2.100, -0.5294, 0.06186, -0.002777}},  // 235U
+  {0.07, {0.4833, 0.1927, -0.1283, -0.006762, 0.002233, -0.0001536}},  // 238U
+  {0.30, {4.757, -5.392, 2.563, -0.6596, 0.07820, -0.003536}},  // 239Pu
+  {0.05, {2.990, -2.882, 1.278, -0.3343, 0.03905, -0.001754}}};  // 241Pu
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+IBDGenerator::IBDGenerator()
+{
+  BuildEnergyTable();
+  BuildAngleTable();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const IBDGenerator& IBDGenerator::Instance()
+{
+  // built by the first thread that asks for it, the others wait
+  static const IBDGenerator generator;
+  return generator;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double IBDGenerator::GetThreshold()
+{
+  const G4double sum = CLHEP::neutron_mass_c2 + CLHEP::electron_mass_c2;
+  return (sum * sum - CLHEP::proton_mass_c2 * CLHEP::proton_mass_c2)
+         / (2. * CLHEP::proton_mass_c2);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double IBDGenerator::ReactorFlux(G4double energy)
+{
+  const G4double e = energy / MeV;
+  G4double flux = 0.;
+  for (const auto& isotope : kIsotopes) {
+    G4double exponent = 0.;
+    for (G4int k = 5; k >= 0; --k) {
+      exponent = exponent * e + isotope.a[k];
+    }
+    flux += isotope.fraction * std::exp(exponent);
+  }
+  return flux;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double IBDGenerator::CrossSection(G4double energy)
+{
+  // zeroth order: sigma ~ E_e p_e, with E_e = E_nu - Delta
+  const G4double positronEnergy = energy - kDelta;
+  if (energy <= GetThreshold() || positronEnergy <= CLHEP::electron_mass_c2) return 0.;
+  const G4double positronMomentum = std::sqrt(
+    positronEnergy * positronEnergy - CLHEP::electron_mass_c2 * CLHEP::electron_mass_c2);
+  return positronEnergy * positronMomentum / (MeV * MeV);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double IBDGenerator::AngularDistribution(G4double energy, G4double cosTheta)
+{
+  // zeroth order: 1 + a v_e cos(theta)
+  const G4double positronEnergy = std::max(energy - kDelta, CLHEP::electron_mass_c2);
+  const G4double velocity = std::sqrt(1. - CLHEP::electron_mass_c2 * CLHEP::electron_mass_c2
+                                             / (positronEnergy * positronEnergy));
+  return 0.5 * (1. + kAsymmetry * velocity * cosTheta);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IBDGenerator::BuildEnergyTable()
+{
+  fEMin = GetThreshold();
+  fEMax = kEMax;
+  fBinWidth = (fEMax - fEMin) / kNofEnergyBins;
+
+  // flux x cross section at the bin centres, scaled to a mean of 1
+  std::vector<G4double> weights(kNofEnergyBins);
+  G4double sum = 0.;
+  for (std::size_t i = 0; i < kNofEnergyBins; ++i) {
+    const G4double energy = fEMin + (i + 0.5) * fBinWidth;
+    weights[i] = ReactorFlux(energy) * CrossSection(energy);
+    sum += weights[i];
+  }
+
+  // Vose's alias method: every bin ends with a probability and an alias,
+  // the bins left over (weight 1 up to rounding) are their own alias
+  fProbability.assign(kNofEnergyBins, 1.);
+  fAlias.resize(kNofEnergyBins);
+  std::vector<std::size_t> small, large;
+  for (std::size_t i = 0; i < kNofEnergyBins; ++i) {
+    weights[i] *= kNofEnergyBins / sum;
+    fAlias[i] = i;
+    (weights[i] < 1. ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    const std::size_t lower = small.back();
+    small.pop_back();
+    const std::size_t upper = large.back();
+    fProbability[lower] = weights[lower];
+    fAlias[lower] = upper;
+    weights[upper] -= 1. - weights[lower];
+    if (weights[upper] < 1.) {
+      large.pop_back();
+      small.push_back(upper);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IBDGenerator::BuildAngleTable()
+{
+  fAngleBinWidth = (fEMax - fEMin) / kNofAngleEnergyBins;
+  fInverseCDF.resize(kNofAngleEnergyBins * kNofAnglePoints);
+
+  const G4double step = 2. / kNofCosSteps;
+  std::vector<G4double> cdf(kNofCosSteps + 1);
+  for (std::size_t j = 0; j < kNofAngleEnergyBins; ++j) {
+    const G4double energy = fEMin + (j + 0.5) * fAngleBinWidth;
+
+    // CDF of cos(theta) on a fine grid (trapezoids)
+    cdf[0] = 0.;
+    G4double previous = AngularDistribution(energy, -1.);
+    for (std::size_t k = 1; k <= kNofCosSteps; ++k) {
+      const G4double current = AngularDistribution(energy, -1. + k * step);
+      cdf[k] = cdf[k - 1] + 0.5 * (previous + current) * step;
+      previous = current;
+    }
+
+    // inverted on the uniform grid of u, linearly within the fine steps
+    G4double* inverse = &fInverseCDF[j * kNofAnglePoints];
+    std::size_t k = 0;
+    for (std::size_t m = 0; m < kNofAnglePoints; ++m) {
+      const G4double u = cdf.back() * m / (kNofAnglePoints - 1);
+      while (k + 1 < kNofCosSteps && cdf[k + 1] < u) ++k;
+      const G4double width = cdf[k + 1] - cdf[k];
+      const G4double fraction = width > 0. ? (u - cdf[k]) / width : 0.;
+      inverse[m] = std::min(std::max(-1. + (k + fraction) * step, -1.), 1.);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double IBDGenerator::SampleEnergy(G4double u, G4double v) const
+{
+  const G4double x = u * kNofEnergyBins;
+  const auto i = std::min(static_cast<std::size_t>(x), kNofEnergyBins - 1);
+  const std::size_t bin = (x - i < fProbability[i]) ? i : fAlias[i];
+  return fEMin + (bin + v) * fBinWidth;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double IBDGenerator::SampleCosTheta(G4double energy, G4double u) const
+{
+  const G4double bin = std::min(std::max((energy - fEMin) / fAngleBinWidth, 0.),
+                                kNofAngleEnergyBins - 1.);
+  const G4double* inverse = &fInverseCDF[static_cast<std::size_t>(bin) * kNofAnglePoints];
+  const G4double x = u * (kNofAnglePoints - 1);
+  const auto k = std::min(static_cast<std::size_t>(x), kNofAnglePoints - 2);
+  return inverse[k] + (x - k) * (inverse[k + 1] - inverse[k]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IBDGenerator::GeneratePrimaryVertex(G4Event* event, const G4ThreeVector& position,
+                                         const G4ThreeVector& direction) const
+{
+  G4double u[4];
+  G4Random::getTheEngine()->flatArray(4, u);
+  const G4double energy = SampleEnergy(u[0], u[1]);
+  const G4double cosTheta = SampleCosTheta(energy, u[2]);
+  const G4double sinTheta = std::sqrt(std::max(0., 1. - cosTheta * cosTheta));
+  const G4double phi = CLHEP::twopi * u[3];
+
+  // positron energy with the first order recoil correction (Vogel-Beacom):
+  // E_e = E_e0 (1 - E_nu / M (1 - v_e0 cos(theta))) - y^2 / M
+  const G4double me = CLHEP::electron_mass_c2;
+  const G4double ySquare = 0.5 * (kDelta * kDelta - me * me);
+  const G4double energy0 = std::max(energy - kDelta, me);
+  const G4double velocity0 = std::sqrt(1. - me * me / (energy0 * energy0));
+  G4double positronEnergy =
+    energy0 * (1. - energy / kNucleonMass * (1. - velocity0 * cosTheta)) - ySquare / kNucleonMass;
+  positronEnergy = std::max(positronEnergy, me);
+  const G4double positronMomentum = std::sqrt(positronEnergy * positronEnergy - me * me);
+
+  G4ThreeVector positronDirection(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+  positronDirection.rotateUz(direction);
+  const G4ThreeVector momentum = positronMomentum * positronDirection;
+  // the neutron takes the rest of the antineutrino momentum
+  const G4ThreeVector neutronMomentum = energy * direction - momentum;
+
+  auto vertex = new G4PrimaryVertex(position, 0.);
+  vertex->SetPrimary(
+    new G4PrimaryParticle(G4Positron::Definition(), momentum.x(), momentum.y(), momentum.z()));
+  vertex->SetPrimary(new G4PrimaryParticle(G4Neutron::Definition(), neutronMomentum.x(),
+                                           neutronMomentum.y(), neutronMomentum.z()));
+  event->AddPrimaryVertex(vertex);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/NeutronHPPhysics.cc
+/// \brief Implementation of the B1::NeutronHPPhysics class
+
+#include "NeutronHPPhysics.hh"
+
+#include "G4HadronElasticProcess.hh"
+#include "G4HadronInelasticProcess.hh"
+#include "G4Neutron.hh"
+#include "G4NeutronCaptureProcess.hh"
+#include "G4ParticleHPCapture.hh"
+#include "G4ParticleHPCaptureData.hh"
+#include "G4ParticleHPElastic.hh"
+#include "G4ParticleHPElasticData.hh"
+#include "G4ParticleHPInelastic.hh"
+#include "G4ParticleHPInelasticData.hh"
+#include "G4ProcessManager.hh"
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NeutronHPPhysics::NeutronHPPhysics() : G4VPhysicsConstructor("NeutronHP") {}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronHPPhysics::ConstructParticle()
+{
+  G4Neutron::Definition();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronHPPhysics::ConstructProcess()
+{
+  const auto neutron = G4Neutron::Definition();
+  G4ProcessManager* processManager = neutron->GetProcessManager();
+
+  auto elastic = new G4HadronElasticProcess();
+  elastic->AddDataSet(new G4ParticleHPElasticData());
+  elastic->RegisterMe(new G4ParticleHPElastic());
+  processManager->AddDiscreteProcess(elastic);
+
+  auto inelastic = new G4HadronInelasticProcess("neutronInelastic", neutron);
+  inelastic->AddDataSet(new G4ParticleHPInelasticData());
+  inelastic->RegisterMe(new G4ParticleHPInelastic());
+  processManager->AddDiscreteProcess(inelastic);
+
+  auto capture = new G4NeutronCaptureProcess();
+  capture->AddDataSet(new G4ParticleHPCaptureData());
+  capture->RegisterMe(new G4ParticleHPCapture());
+  processManager->AddDiscreteProcess(capture);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,146 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/OpticalSpectra.cc
+/// \brief Implementation of the B1::OpticalSpectra class
+
+#include "OpticalSpectra.hh"
+
+#include "SpectralDataLoader.hh"
+
+#include "G4Exception.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const OpticalSpectra& OpticalSpectra::Instance()
+{
+  static const OpticalSpectra instance;
+  return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OpticalSpectra::SetEmissionFile(const G4String& fileName)
+{
+  if (CheckNotBuilt("emission file")) fgEmissionFile = fileName;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OpticalSpectra::SetCacheDirectory(const G4String& directory)
+{
+  if (CheckNotBuilt("cache directory")) fgCacheDirectory = directory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool OpticalSpectra::CheckNotBuilt(const G4String& what)
+{
+  if (!fgBuilt) return true;
+
+  G4ExceptionDescription ed;
+  ed << "The optical spectra are already built; the " << what << " is ignored.";
+  G4Exception("OpticalSpectra::CheckNotBuilt()", "B1Spectra101", JustWarning, ed);
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OpticalSpectra::AddProperty(G4MaterialPropertiesTable* mpt, const G4String& key,
+                                 const SpectralTable& table, G4bool createNewKey)
+{
+  mpt->AddProperty(key, table.GetEnergies(), table.GetValues(), createNewKey);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+OpticalSpectra::OpticalSpectra()
+{
+  fgBuilt = true;
+
+  // Bi-MSB emission spectrum, sorted in energy and normalised
+  std::vector<G4double> bisEnergies, bisIntensities;
+  if (!SpectralDataLoader(fgCacheDirectory).Load(fgEmissionFile, bisEnergies, bisIntensities)) {
+    G4ExceptionDescription ed;
+    ed << "Using a two-point fallback Bi-MSB emission spectrum.";
+    G4Exception("OpticalSpectra::OpticalSpectra()", "B1Spectra102", JustWarning, ed);
+    bisEnergies = {2.0 * eV, 3.5 * eV};
+    bisIntensities = {0.0, 1.0};
+  }
+
+  // Common grid: 2.0 - 3.6 eV in 5 meV steps, widened to the emission range
+  const G4double gridStep = 0.005 * eV;
+  G4double eMin = std::min(2.0 * eV, bisEnergies.front());
+  G4double eMax = std::max(3.6 * eV, bisEnergies.back());
+  auto nofPoints = static_cast<std::size_t>(std::ceil((eMax - eMin) / gridStep)) + 1;
+  SpectralTable grid(eMin, eMax, nofPoints);
+
+  fRIndexLAB = grid;
+  fRIndexLAB.Fill(1.48);
+  fRIndexPMMA = grid;
+  fRIndexPMMA.Fill(1.49);
+  fRIndexPMT = grid;
+  fRIndexPMT.Fill(1.52);
+
+  fAbsLengthLABGd = grid;
+  fAbsLengthLABGd.Fill(6. * m);  // Gd-LAB = 6 m
+  fAbsLengthLABPure = grid;
+  fAbsLengthLABPure.Fill(12. * m);  // pure LAB = 12 m
+  fAbsLengthPMMA = grid;
+  fAbsLengthPMMA.Fill(5. * m);
+  fAbsLengthPMT = grid;
+  fAbsLengthPMT.Fill(1. * nm);
+
+  // Bi-MSB emission (FASTCOMPONENT), normalised to a maximum of 1
+  fBisMSBEmission = grid;
+  fBisMSBEmission.Fill(bisEnergies, bisIntensities, true);
+  fBisMSBEmission.Normalise();
+
+  fMylarReflectivity = grid;
+  fMylarReflectivity.Fill(0.90);
+
+  // Photocathode quantum efficiency; clamped to the edge values outside
+  const std::vector<G4double> qeEnergies = {
+    2.175 * eV, 2.214 * eV, 2.254 * eV, 2.296 * eV, 2.339 * eV, 2.384 * eV,
+    2.431 * eV, 2.480 * eV, 2.530 * eV, 2.583 * eV, 2.638 * eV, 2.695 * eV,
+    2.755 * eV, 2.818 * eV, 2.883 * eV, 2.952 * eV, 3.024 * eV, 3.100 * eV,
+    3.179 * eV, 3.263 * eV, 3.351 * eV, 3.444 * eV, 3.542 * eV};
+  const std::vector<G4double> qeValues(qeEnergies.size(), 0.28);
+  fQE = grid;
+  fQE.Fill(qeEnergies, qeValues);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
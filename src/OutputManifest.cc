@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/OutputManifest.cc
+/// \brief Implementation of the B1::OutputManifest class
+
+#include "OutputManifest.hh"
+
+#include "G4AutoLock.hh"
+#include "G4Exception.hh"
+
+#include <fstream>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+OutputManifest& OutputManifest::Instance()
+{
+  static OutputManifest instance;
+  return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OutputManifest::Add(const G4String& manifestName, const G4String& fileName)
+{
+  G4AutoLock lock(&fMutex);
+  fManifests[manifestName].insert(fileName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OutputManifest::Write()
+{
+  G4AutoLock lock(&fMutex);
+  for (const auto& [manifestName, fileNames] : fManifests) {
+    std::ofstream out(manifestName);
+    if (!out) {
+      G4ExceptionDescription ed;
+      ed << "Cannot write the manifest " << manifestName << ".";
+      G4Exception("OutputManifest::Write()", "B1Output001", JustWarning, ed);
+      continue;
+    }
+    for (const auto& fileName : fileNames) {
+      out << fileName << '\n';
+    }
+    G4cout << " Output files listed in " << manifestName << " (" << fileNames.size()
+           << " files)" << G4endl;
+  }
+  fManifests.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
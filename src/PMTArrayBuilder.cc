@@ -0,0 +1,428 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PMTArrayBuilder.cc
+/// \brief Implementation of the B1::PMTArrayBuilder class
+
+#include "PMTArrayBuilder.hh"
+
+#include "PMTParameterisation.hh"
+
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4PVParameterised.hh"
+#include "G4PVPlacement.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4RunManager.hh"
+#include "G4StateManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Tubs.hh"
+#include "G4UIcommand.hh"
+#include "G4UnitsTable.hh"
+#include "G4VisAttributes.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
+
+namespace B1
+{
+
+namespace
+{
+const G4String kEnvelopeName = "PMTArray";
+// clearance between the PMTs and their envelope
+const G4double kMargin = 0.5 * mm;
+
+// Numbers of a layout command followed by an optional length unit
+G4bool ParseCommand(const G4String& command, const G4String& parameters,
+                    std::vector<G4double>& values)
+{
+  std::istringstream is(parameters);
+  for (auto& value : values) {
+    if (!(is >> value)) {
+      G4ExceptionDescription ed;
+      ed << "Bad parameters for " << command << ": \"" << parameters << "\".";
+      G4Exception("PMTArrayBuilder::ParseCommand()", "B1PMTArray001", JustWarning, ed);
+      return false;
+    }
+  }
+  G4String unit = "mm";
+  is >> unit;
+  // an unknown unit would scale all the values to 0
+  if (!G4UnitDefinition::IsUnitDefined(unit) || G4UnitDefinition::GetCategory(unit) != "Length") {
+    G4ExceptionDescription ed;
+    ed << "Bad length unit for " << command << ": \"" << unit << "\".";
+    G4Exception("PMTArrayBuilder::ParseCommand()", "B1PMTArray001", JustWarning, ed);
+    return false;
+  }
+  values.push_back(G4UIcommand::ValueOf(unit.c_str()));
+  return true;
+}
+
+void BadLayout(const char* method, const G4String& reason)
+{
+  G4ExceptionDescription ed;
+  ed << reason << "; the section is not added.";
+  G4Exception(method, "B1PMTArray002", JustWarning, ed);
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PMTArrayBuilder::PMTArrayBuilder()
+{
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PMTArrayBuilder::~PMTArrayBuilder() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::AddRing(G4double z, G4double radius, G4int nofPMTs)
+{
+  if (nofPMTs <= 0) {
+    BadLayout("PMTArrayBuilder::AddRing()", "The ring has no PMT");
+    return;
+  }
+  fSections.push_back({false, {{radius, z, nofPMTs}}});
+  Modified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::AddCap(G4double z, G4double rMax, G4double pitch)
+{
+  if (pitch <= 0.) {
+    BadLayout("PMTArrayBuilder::AddCap()", "The pitch of the cap is not positive");
+    return;
+  }
+  if (pitch < 2. * fPMTRadius) {
+    BadLayout("PMTArrayBuilder::AddCap()",
+              "The pitch of the cap is smaller than the PMT diameter: the PMTs overlap");
+    return;
+  }
+
+  // a central PMT, then rings spaced by the pitch with as many PMTs as fit
+  Section section = {false, {{0., z, 1}}};
+  for (G4int j = 1; j * pitch <= rMax; ++j) {
+    auto nofPMTs = static_cast<G4int>(twopi * j);  // circumference / pitch
+    section.rings.push_back({j * pitch, z, nofPMTs});
+  }
+  fSections.push_back(section);
+  Modified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::AddWall(G4double radius, G4double zMin, G4double zMax, G4int nofRows,
+                              G4int nofPerRow)
+{
+  if (nofRows <= 0 || nofPerRow <= 0) {
+    BadLayout("PMTArrayBuilder::AddWall()", "The wall has no PMT");
+    return;
+  }
+  Section section = {true, {}};
+  for (G4int row = 0; row < nofRows; ++row) {
+    G4double z = (nofRows > 1) ? zMin + row * (zMax - zMin) / (nofRows - 1) : 0.5 * (zMin + zMax);
+    section.rings.push_back({radius, z, nofPerRow});
+  }
+  fSections.push_back(section);
+  Modified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::Clear()
+{
+  fSections.clear();
+  Modified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::SetDefaultLayout(G4double zOffset, G4double radius, G4int nofPerRing)
+{
+  fDefaultSections = {{false, {{radius, +zOffset, nofPerRing}}},
+                      {false, {{radius, -zOffset, nofPerRing}}}};
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::SetUseEnvelopes(G4bool value)
+{
+  fUseEnvelopes = value;
+  Modified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::SetSmartless(G4double value)
+{
+  fSmartless = value;
+  Modified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::SetOptimise(G4bool value)
+{
+  fOptimise = value;
+  Modified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::Modified() const
+{
+  // the voxels are rebuilt with the geometry, hence also for the tuning
+  auto runManager = G4RunManager::GetRunManager();
+  if (runManager && G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle) {
+    runManager->ReinitializeGeometry();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PMTArrayBuilder::Build(G4LogicalVolume* pmt, G4LogicalVolume* mother,
+                             G4Material* envelopeMaterial, G4bool checkOverlaps)
+{
+  // the parameterisations of the previous geometry, if any, are gone with it
+  fParameterisations.clear();
+
+  const auto pmtSolid = static_cast<const G4Tubs*>(pmt->GetSolid());
+  const G4double pmtRadius = pmtSolid->GetOuterRadius();
+  const G4double pmtHalfLength = pmtSolid->GetZHalfLength();
+
+  const std::vector<Section>& sections = GetSections();
+  G4int copyNo = 0;
+  for (std::size_t k = 0; k < sections.size(); ++k) {
+    const Section& section = sections[k];
+
+    // extent of the section, whose centre is the origin of the envelope
+    G4double rMin = DBL_MAX, rMax = 0., zMin = DBL_MAX, zMax = -DBL_MAX;
+    for (const auto& ring : section.rings) {
+      rMin = std::min(rMin, ring.radius);
+      rMax = std::max(rMax, ring.radius);
+      zMin = std::min(zMin, ring.z);
+      zMax = std::max(zMax, ring.z);
+    }
+    G4double zCentre = 0.5 * (zMin + zMax);
+
+    auto parameterisation = new PMTParameterisation;
+    fParameterisations.emplace_back(parameterisation);
+    for (const auto& ring : section.rings) {
+      for (G4int i = 0; i < ring.nofPMTs; ++i) {
+        G4double phi = twopi * i / ring.nofPMTs;
+        G4RotationMatrix rotation;
+        if (section.wall) {
+          // PMT axis along the radius
+          rotation.rotateY(halfpi);
+          rotation.rotateZ(phi);
+        }
+        G4ThreeVector position(ring.radius * std::cos(phi), ring.radius * std::sin(phi),
+                               ring.z - zCentre);
+        parameterisation->AddPMT(position, rotation);
+      }
+    }
+    G4int nofPMTs = parameterisation->GetNofPMTs();
+
+    if (!fUseEnvelopes) {
+      for (G4int i = 0; i < nofPMTs; ++i) {
+        new G4PVPlacement(parameterisation->GetFrameRotation(i),
+                          parameterisation->GetPosition(i) + G4ThreeVector(0., 0., zCentre), pmt,
+                          "PMT", mother, false, copyNo + i, checkOverlaps);
+      }
+      copyNo += nofPMTs;
+      continue;
+    }
+
+    // envelope: a disc around a cap, a cylindrical shell around a wall
+    G4Tubs* envelopeSolid = nullptr;
+    G4String name = kEnvelopeName + std::to_string(k);
+    if (section.wall) {
+      G4double rOuter = std::hypot(rMax + pmtHalfLength, pmtRadius);
+      envelopeSolid = new G4Tubs(name, rMin - pmtHalfLength - kMargin, rOuter + kMargin,
+                                 0.5 * (zMax - zMin) + pmtRadius + kMargin, 0., twopi);
+    }
+    else {
+      G4double rInner = std::max(rMin - pmtRadius - kMargin, 0.);
+      envelopeSolid = new G4Tubs(name, rInner, rMax + pmtRadius + kMargin,
+                                 pmtHalfLength + kMargin, 0., twopi);
+    }
+    auto envelope = new G4LogicalVolume(envelopeSolid, envelopeMaterial, name);
+    envelope->SetVisAttributes(G4VisAttributes::GetInvisible());
+    new G4PVPlacement(nullptr, G4ThreeVector(0., 0., zCentre), envelope, name, mother, false,
+                      copyNo, checkOverlaps);
+    new G4PVParameterised("PMT", pmt, envelope, kUndefined, nofPMTs, parameterisation,
+                          checkOverlaps);
+    copyNo += nofPMTs;
+  }
+
+  return copyNo;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::Tune() const
+{
+  for (auto volume : *G4LogicalVolumeStore::GetInstance()) {
+    if (volume->GetName().rfind(kEnvelopeName, 0) != 0) continue;
+    volume->SetSmartless(fSmartless);
+    volume->SetOptimisation(fOptimise);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PMTArrayBuilder::GetNofPMTs() const
+{
+  G4int nofPMTs = 0;
+  for (const auto& section : GetSections()) {
+    for (const auto& ring : section.rings) nofPMTs += ring.nofPMTs;
+  }
+  return nofPMTs;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PMTArrayBuilder::GetSymmetryFold() const
+{
+  G4int fold = 0;
+  for (const auto& section : GetSections()) {
+    for (const auto& ring : section.rings) {
+      if (ring.radius <= 0. || (fold > 0 && ring.nofPMTs != fold)) return 1;
+      fold = ring.nofPMTs;
+    }
+  }
+  return std::max(fold, 1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<G4double> PMTArrayBuilder::GetParameters() const
+{
+  std::vector<G4double> parameters = {G4double(fUseEnvelopes)};
+  for (const auto& section : GetSections()) {
+    parameters.push_back(section.wall);
+    for (const auto& ring : section.rings) {
+      parameters.insert(parameters.end(), {ring.radius, ring.z, G4double(ring.nofPMTs)});
+    }
+  }
+  return parameters;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::AddRingCommand(const G4String& parameters)
+{
+  std::vector<G4double> values(3);
+  if (!ParseCommand("addRing", parameters, values)) return;
+  AddRing(values[0] * values[3], values[1] * values[3], static_cast<G4int>(values[2]));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::AddCapCommand(const G4String& parameters)
+{
+  std::vector<G4double> values(3);
+  if (!ParseCommand("addCap", parameters, values)) return;
+  AddCap(values[0] * values[3], values[1] * values[3], values[2] * values[3]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::AddWallCommand(const G4String& parameters)
+{
+  std::vector<G4double> values(5);
+  if (!ParseCommand("addWall", parameters, values)) return;
+  AddWall(values[0] * values[5], values[1] * values[5], values[2] * values[5],
+          static_cast<G4int>(values[3]), static_cast<G4int>(values[4]));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTArrayBuilder::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/det/pmt/", "PMT array layout");
+
+  fMessenger->DeclareMethod("clear", &PMTArrayBuilder::Clear)
+    .SetGuidance("Remove all sections (the default layout is used if none is added).")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("addRing", &PMTArrayBuilder::AddRingCommand)
+    .SetGuidance("Add a ring of PMTs facing along z: z radius nofPMTs [unit=mm]")
+    .SetParameterName("parameters", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("addCap", &PMTArrayBuilder::AddCapCommand)
+    .SetGuidance("Add an end cap of concentric rings: z rMax pitch [unit=mm]")
+    .SetGuidance("The pitch must be at least the PMT diameter.")
+    .SetParameterName("parameters", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("addWall", &PMTArrayBuilder::AddWallCommand)
+    .SetGuidance("Add a wall of PMTs facing the axis:")
+    .SetGuidance("  radius zMin zMax nofRows nofPerRow [unit=mm]")
+    .SetParameterName("parameters", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("envelopes", &PMTArrayBuilder::SetUseEnvelopes)
+    .SetGuidance("Place the sections in envelopes, as parameterised volumes.")
+    .SetGuidance("If false, every PMT is a placement in the mother volume.")
+    .SetParameterName("envelopes", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("smartless", &PMTArrayBuilder::SetSmartless)
+    .SetGuidance("Voxel density (smartless) of the envelopes: average number of")
+    .SetGuidance("voxels per daughter for the navigation optimisation (default 2).")
+    .SetParameterName("smartless", false)
+    .SetRange("smartless>0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("optimise", &PMTArrayBuilder::SetOptimise)
+    .SetGuidance("Build smart voxels for the envelopes.")
+    .SetParameterName("optimise", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,235 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PMTDigitizer.cc
+/// \brief Implementation of the B1::PMTDigitizer class
+
+#include "PMTDigitizer.hh"
+
+#include "PMTDigi.hh"
+#include "PMTHit.hh"
+#include "PhotonBuffer.hh"
+
+#include "G4DigiManager.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PMTDigitizer::PMTDigitizer(const G4String& name, const PhotonBuffer& photons)
+  : G4VDigitizerModule(name), fPhotons(photons)
+{
+  collectionName.push_back("PMTDigitsCollection");
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PMTDigitizer::~PMTDigitizer() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::size_t PMTDigitizer::GetNofSamples() const
+{
+  return static_cast<std::size_t>(std::ceil(fWindow / fSamplingPeriod));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTDigitizer::Digitize()
+{
+  if (!fEnabled) return;
+
+  auto digiManager = G4DigiManager::GetDMpointer();
+  if (fPMTHCID < 0) fPMTHCID = digiManager->GetHitsCollectionID("PMTHitsCollection");
+  auto hitsCollection =
+    static_cast<const PMTHitsCollection*>(digiManager->GetHitsCollection(fPMTHCID));
+  if (!hitsCollection) return;
+
+  if (!fKernelValid) BuildKernel();
+
+  const auto nofPMTs = static_cast<G4int>(hitsCollection->entries());
+  const std::size_t nofSamples = GetNofSamples();
+  const std::size_t nofKernel = fKernel.size();
+
+  // Histogram the photoelectron times per PMT
+  fCounts.assign(nofPMTs * nofSamples, 0.f);
+  const G4double invPeriod = 1. / fSamplingPeriod;
+  const auto& times = fPhotons.GetTimes();
+  const auto& pmtIDs = fPhotons.GetPMTIDs();
+  for (std::size_t k = 0; k < fPhotons.Size(); ++k) {
+    G4double x = (times[k] - fWindowStart) * invPeriod;
+    if (x < 0. || x >= nofSamples || pmtIDs[k] < 0 || pmtIDs[k] >= nofPMTs) continue;
+    fCounts[pmtIDs[k] * nofSamples + static_cast<std::size_t>(x)] += 1.f;
+  }
+
+  auto digitsCollection = new PMTDigitsCollection(moduleName, collectionName[0]);
+  const G4float* kernel = fKernel.data();
+  for (G4int pmtID = 0; pmtID < nofPMTs; ++pmtID) {
+    auto digi = new PMTDigi(pmtID, nofSamples);
+    G4float* samples = digi->GetSamples().data();
+    const G4float* counts = &fCounts[pmtID * nofSamples];
+
+    // Convolution with the SPE pulse: for every occupied bin, a contiguous
+    // multiply-add of the kernel into the waveform
+    for (std::size_t j = 0; j < nofSamples; ++j) {
+      const G4float c = counts[j];
+      if (c == 0.f) continue;
+      const std::size_t n = std::min(nofKernel, nofSamples - j);
+      G4float* out = samples + j;
+      for (std::size_t k = 0; k < n; ++k) {
+        out[k] += c * kernel[k];
+      }
+    }
+
+    if (fNoise > 0.) {
+      for (std::size_t j = 0; j < nofSamples; ++j) {
+        samples[j] += static_cast<G4float>(CLHEP::RandGauss::shoot(0., fNoise));
+      }
+    }
+
+    digitsCollection->insert(digi);
+  }
+
+  StoreDigiCollection(digitsCollection);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTDigitizer::BuildKernel()
+{
+  // Pulse shape exp(-t/fall) - exp(-t/rise), sampled at the bin centres
+  // up to eight fall times and normalised to unit sum
+  auto nofKernel = static_cast<std::size_t>(std::ceil(8. * fFallTime / fSamplingPeriod));
+  nofKernel = std::max<std::size_t>(nofKernel, 1);
+  fKernel.assign(nofKernel, 0.f);
+
+  G4double sum = 0.;
+  for (std::size_t k = 0; k < nofKernel; ++k) {
+    G4double t = (k + 0.5) * fSamplingPeriod;
+    G4double value = std::exp(-t / fFallTime);
+    if (fRiseTime > 0. && fRiseTime != fFallTime) value -= std::exp(-t / fRiseTime);
+    fKernel[k] = static_cast<G4float>(value);
+    sum += value;
+  }
+  if (sum > 0.) {
+    for (auto& value : fKernel) value = static_cast<G4float>(value / sum);
+  }
+
+  fKernelValid = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTDigitizer::SetSamplingPeriod(G4double value)
+{
+  fSamplingPeriod = value;
+  fKernelValid = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTDigitizer::SetWindow(G4double value)
+{
+  fWindow = value;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTDigitizer::SetRiseTime(G4double value)
+{
+  fRiseTime = value;
+  fKernelValid = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTDigitizer::SetFallTime(G4double value)
+{
+  fFallTime = value;
+  fKernelValid = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTDigitizer::DefineCommands()
+{
+  fMessenger =
+    std::make_unique<G4GenericMessenger>(this, "/B1/digi/", "PMT waveform digitization");
+
+  fMessenger->DeclareProperty("enable", fEnabled)
+    .SetGuidance("Enable the PMT waveform digitization.")
+    .SetParameterName("enable", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareMethodWithUnit("samplingPeriod", "ns", &PMTDigitizer::SetSamplingPeriod)
+    .SetGuidance("Set the waveform sampling period.")
+    .SetParameterName("period", false)
+    .SetRange("period>0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareMethodWithUnit("window", "ns", &PMTDigitizer::SetWindow)
+    .SetGuidance("Set the length of the acquisition window.")
+    .SetParameterName("window", false)
+    .SetRange("window>0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclarePropertyWithUnit("windowStart", "ns", fWindowStart)
+    .SetGuidance("Set the start time of the acquisition window.")
+    .SetParameterName("start", false)
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareMethodWithUnit("riseTime", "ns", &PMTDigitizer::SetRiseTime)
+    .SetGuidance("Set the rise time of the single-photoelectron pulse.")
+    .SetParameterName("rise", false)
+    .SetRange("rise>=0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareMethodWithUnit("fallTime", "ns", &PMTDigitizer::SetFallTime)
+    .SetGuidance("Set the fall time of the single-photoelectron pulse.")
+    .SetParameterName("fall", false)
+    .SetRange("fall>0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("noise", fNoise)
+    .SetGuidance("Set the RMS of the gaussian noise added to every sample,")
+    .SetGuidance("in photoelectrons per sample (0 = no noise).")
+    .SetParameterName("noise", false)
+    .SetRange("noise>=0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
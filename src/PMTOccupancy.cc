@@ -0,0 +1,134 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PMTOccupancy.cc
+/// \brief Implementation of the B1::PMTOccupancy class
+
+#include "PMTOccupancy.hh"
+
+#include "PhotonBuffer.hh"
+
+#include "G4Exception.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PMTOccupancy::PMTOccupancy() : G4VAccumulable("PMTOccupancy") {}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTOccupancy::Resize(std::size_t size)
+{
+  if (size <= fPhotoelectrons.size()) return;
+  fPhotoelectrons.resize(size, 0.);
+  fNofHitEvents.resize(size, 0.);
+  fLastEvent.resize(size, 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTOccupancy::Fill(const PhotonBuffer& photons)
+{
+  fNofEvents += 1.;
+  for (auto pmtID : photons.GetPMTIDs()) {
+    auto i = static_cast<std::size_t>(pmtID);
+    Resize(i + 1);
+    fPhotoelectrons[i] += 1.;
+    if (fLastEvent[i] != fNofEvents) {
+      fLastEvent[i] = fNofEvents;
+      fNofHitEvents[i] += 1.;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTOccupancy::Merge(const G4VAccumulable& other)
+{
+  const auto& otherOccupancy = static_cast<const PMTOccupancy&>(other);
+  fNofEvents += otherOccupancy.fNofEvents;
+  Resize(otherOccupancy.fPhotoelectrons.size());
+  for (std::size_t i = 0; i < otherOccupancy.fPhotoelectrons.size(); ++i) {
+    fPhotoelectrons[i] += otherOccupancy.fPhotoelectrons[i];
+    fNofHitEvents[i] += otherOccupancy.fNofHitEvents[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTOccupancy::Reset()
+{
+  fNofEvents = 0.;
+  fPhotoelectrons.clear();
+  fNofHitEvents.clear();
+  fLastEvent.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTOccupancy::Write(const G4String& fileName) const
+{
+  std::ofstream out(fileName);
+  if (!out) {
+    G4ExceptionDescription ed;
+    ed << "Cannot write the PMT occupancy to " << fileName << ".";
+    G4Exception("PMTOccupancy::Write()", "B1Summary001", JustWarning, ed);
+    return;
+  }
+  out << "pmt,photoelectrons,events,occupancy\n";
+  for (std::size_t i = 0; i < fPhotoelectrons.size(); ++i) {
+    G4double occupancy = (fNofEvents > 0.) ? fNofHitEvents[i] / fNofEvents : 0.;
+    out << i << ',' << fPhotoelectrons[i] << ',' << fNofHitEvents[i] << ',' << occupancy
+        << '\n';
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTOccupancy::Print(G4PrintOptions) const
+{
+  if (fNofEvents <= 0.) return;
+
+  G4double photoelectrons = std::accumulate(fPhotoelectrons.begin(), fPhotoelectrons.end(), 0.);
+  auto nofHitPMTs =
+    std::count_if(fNofHitEvents.begin(), fNofHitEvents.end(), [](G4double n) { return n > 0.; });
+  G4double maxHitEvents =
+    fNofHitEvents.empty() ? 0. : *std::max_element(fNofHitEvents.begin(), fNofHitEvents.end());
+
+  G4cout << G4endl << " PMT occupancy: " << photoelectrons / fNofEvents
+         << " photoelectrons per event, " << nofHitPMTs << " PMTs hit, maximum occupancy "
+         << maxHitEvents / fNofEvents << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
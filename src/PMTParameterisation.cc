@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PMTParameterisation.cc
+/// \brief Implementation of the B1::PMTParameterisation class
+
+#include "PMTParameterisation.hh"
+
+#include "G4VPhysicalVolume.hh"
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTParameterisation::AddPMT(const G4ThreeVector& position,
+                                 const G4RotationMatrix& rotation)
+{
+  fPositions.push_back(position);
+  if (rotation.isIdentity()) {
+    fFrameRotations.emplace_back();
+  }
+  else {
+    fFrameRotations.push_back(std::make_unique<G4RotationMatrix>(rotation.inverse()));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTParameterisation::ComputeTransformation(const G4int copyNo,
+                                                G4VPhysicalVolume* physVol) const
+{
+  physVol->SetTranslation(fPositions[copyNo]);
+  physVol->SetRotation(fFrameRotations[copyNo].get());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
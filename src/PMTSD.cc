@@ -0,0 +1,152 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PMTSD.cc
+/// \brief Implementation of the B1::PMTSD class
+
+#include "PMTSD.hh"
+
+#include "EventAction.hh"
+#include "OpticalSpectra.hh"
+#include "PhotonInformation.hh"
+#include "PhotonMapGenerator.hh"
+
+#include "G4EventManager.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4SDManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VTouchable.hh"
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PMTSD::PMTSD(const G4String& name, const G4String& hitsCollectionName, G4int nofPMTs)
+  : G4VSensitiveDetector(name), fNofPMTs(nofPMTs), fQE(&OpticalSpectra::Instance().GetQE())
+{
+  collectionName.insert(hitsCollectionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTSD::Initialize(G4HCofThisEvent* hce)
+{
+  // Create hits collection
+  fHitsCollection = new PMTHitsCollection(SensitiveDetectorName, collectionName[0]);
+
+  // Add this collection in hce
+  G4int hcID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
+  hce->AddHitsCollection(hcID, fHitsCollection);
+
+  // One hit per PMT, so that the hit index is the PMT copy number
+  for (G4int i = 0; i < fNofPMTs; ++i) {
+    fHitsCollection->insert(new PMTHit(i));
+  }
+
+  // The photon map is tabulated before the QE
+  fApplyQE = !PhotonMapGenerator::IsActive();
+  fQEScale = OpticalSpectra::GetQEScale();
+  // the random numbers of an event come from its own stream
+  fRandoms.Clear();
+  fMonitor = RunMonitor::GetThreadCounters();
+
+  // The per-photon record goes to the event action buffer of this thread
+  fEventAction =
+    static_cast<EventAction*>(G4EventManager::GetEventManager()->GetUserEventAction());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PMTSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  G4Track* track = step->GetTrack();
+  if (track->GetParticleDefinition() != G4OpticalPhoton::Definition()) return false;
+
+  // When invoked from the boundary process the photon stops on the
+  // photocathode, i.e. at the post-step point; a photon tracked inside
+  // the PMT volume is seen at its pre-step point.
+  const G4StepPoint* point = step->GetPreStepPoint();
+  if (point->GetSensitiveDetector() != this) point = step->GetPostStepPoint();
+
+  // PMT number: copy number within the envelope plus that of the envelope
+  // (the offset of its first PMT, see PMTArrayBuilder)
+  const G4VTouchable* touchable = point->GetTouchable();
+  G4int pmtID = touchable->GetCopyNumber(0) + touchable->GetCopyNumber(1);
+  if (pmtID < 0 || pmtID >= fNofPMTs) return false;
+
+  track->SetTrackStatus(fStopAndKill);
+
+  return RecordPhoton(pmtID, point->GetGlobalTime(), track->GetTotalEnergy(),
+                      track->GetTrackID(),
+                      static_cast<const PhotonInformation*>(track->GetUserInformation()));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PMTSD::RecordPhoton(G4int pmtID, G4double time, G4double energy, G4int trackID,
+                           const PhotonInformation* info)
+{
+  // a photon map made for another PMT array (see SetNofPMTs)
+  if (pmtID < 0 || pmtID >= fNofPMTs) return false;
+
+  G4bool sampledAtBirth = info && !info->IsValidation();
+  G4bool detected = sampledAtBirth || !fApplyQE || fRandoms.Next() <= fQEScale * fQE->Value(energy);
+
+  // validation of the culling at birth: compare with the QE sampled here,
+  // within the time window of the culling
+  if (info && info->IsValidation() && fEventAction) {
+    G4bool inWindow = info->GetTimeWindow() <= 0. || time < info->GetTimeWindow();
+    fEventAction->FillCullingValidation(energy, time, detected && inWindow,
+                                        info->IsAccepted() && inWindow);
+  }
+  if (!detected) return false;
+
+  (*fHitsCollection)[pmtID]->AddPhotoelectron(time, energy);
+  if (fEventAction) fEventAction->RecordPhoton(energy, time, pmtID, trackID);
+  if (fMonitor) RunMonitor::Increment(fMonitor->photonsDetected);
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PMTSD::EndOfEvent(G4HCofThisEvent*)
+{
+  if (verboseLevel > 1) {
+    G4cout << G4endl << "-------->Hits Collection: in this event there are " << fNofPMTs
+           << " PMTs: " << G4endl;
+    for (G4int i = 0; i < fNofPMTs; ++i) {
+      (*fHitsCollection)[i]->Print();
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
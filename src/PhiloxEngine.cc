@@ -0,0 +1,199 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PhiloxEngine.cc
+/// \brief Implementation of the B1::PhiloxEngine class
+
+#include "PhiloxEngine.hh"
+
+#include "G4Exception.hh"
+#include "G4ios.hh"
+
+#include <fstream>
+
+namespace B1
+{
+
+namespace
+{
+// Philox4x32 multipliers and Weyl key increments
+const std::uint32_t kM0 = 0xD2511F53;
+const std::uint32_t kM1 = 0xCD9E8D57;
+const std::uint32_t kW0 = 0x9E3779B9;
+const std::uint32_t kW1 = 0xBB67AE85;
+const G4int kNofRounds = 10;
+
+inline void MulHiLo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo)
+{
+  const std::uint64_t product = std::uint64_t(a) * b;
+  hi = static_cast<std::uint32_t>(product >> 32);
+  lo = static_cast<std::uint32_t>(product);
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhiloxEngine::PhiloxEngine(std::uint64_t seed)
+{
+  SetStream(seed, 0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhiloxEngine::SetStream(std::uint64_t seed, std::uint64_t stream)
+{
+  fKey = {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+  fStream = stream;
+  fBlock = 0;
+  fNext = 4;
+  theSeed = static_cast<long>(seed);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhiloxEngine::Counter PhiloxEngine::Generate(Counter counter, Key key)
+{
+  for (G4int round = 0; round < kNofRounds; ++round) {
+    std::uint32_t hi0, lo0, hi1, lo1;
+    MulHiLo(kM0, counter[0], hi0, lo0);
+    MulHiLo(kM1, counter[2], hi1, lo1);
+    counter = {hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0};
+    key[0] += kW0;
+    key[1] += kW1;
+  }
+  return counter;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhiloxEngine::NextBlock()
+{
+  fOutput = Generate({static_cast<std::uint32_t>(fBlock), static_cast<std::uint32_t>(fBlock >> 32),
+                      static_cast<std::uint32_t>(fStream), static_cast<std::uint32_t>(fStream >> 32)},
+                     fKey);
+  fNext = 0;
+  ++fBlock;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhiloxEngine::flatArray(const int size, double* vect)
+{
+  // a single virtual call for the whole array
+  for (int i = 0; i < size; ++i) {
+    vect[i] = Next();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhiloxEngine::setSeed(long seed, int)
+{
+  SetStream(static_cast<std::uint64_t>(seed), fStream);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhiloxEngine::setSeeds(const long* seeds, int)
+{
+  // zero-terminated list: the first two seeds make the key
+  if (!seeds || seeds[0] == 0) return;
+  std::uint64_t seed = static_cast<std::uint32_t>(seeds[0]);
+  if (seeds[1] != 0) seed |= std::uint64_t(static_cast<std::uint32_t>(seeds[1])) << 32;
+  SetStream(seed, fStream);
+  theSeeds = seeds;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::ostream& PhiloxEngine::put(std::ostream& os) const
+{
+  // the position in the stream is that of the next block to generate
+  os << name() << '\n'
+     << fKey[0] << ' ' << fKey[1] << ' ' << fStream << ' ' << fBlock << ' ' << fNext;
+  for (auto word : fOutput) os << ' ' << word;
+  return os << '\n';
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::istream& PhiloxEngine::get(std::istream& is)
+{
+  std::string engineName;
+  is >> engineName;
+  if (engineName != name()) {
+    G4ExceptionDescription ed;
+    ed << "The status is of a " << engineName << " engine; not restored.";
+    G4Exception("PhiloxEngine::get()", "B1Random001", JustWarning, ed);
+    is.clear(std::ios::badbit | is.rdstate());
+    return is;
+  }
+  return getState(is);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::istream& PhiloxEngine::getState(std::istream& is)
+{
+  is >> fKey[0] >> fKey[1] >> fStream >> fBlock >> fNext;
+  for (auto& word : fOutput) is >> word;
+  if (fNext > 4 || fNext % 2 != 0) fNext = 4;
+  return is;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhiloxEngine::saveStatus(const char filename[]) const
+{
+  std::ofstream out(filename);
+  put(out);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhiloxEngine::restoreStatus(const char filename[])
+{
+  std::ifstream in(filename);
+  if (!in) {
+    G4ExceptionDescription ed;
+    ed << "Cannot read the engine status " << filename << ".";
+    G4Exception("PhiloxEngine::restoreStatus()", "B1Random002", JustWarning, ed);
+    return;
+  }
+  get(in);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhiloxEngine::showStatus() const
+{
+  G4cout << " PhiloxEngine: key " << fKey[0] << ' ' << fKey[1] << ", stream " << fStream
+         << ", block " << fBlock << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,201 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PhotonLimits.cc
+/// \brief Implementation of the B1::PhotonLimits class
+
+#include "PhotonLimits.hh"
+
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+#include "G4OpBoundaryProcess.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4ProcessManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+
+namespace B1
+{
+
+namespace
+{
+G4bool IsReflection(G4OpBoundaryProcessStatus status)
+{
+  switch (status) {
+    case FresnelReflection:
+    case TotalInternalReflection:
+    case LambertianReflection:
+    case LobeReflection:
+    case SpikeReflection:
+    case BackScattering:
+    case CoatedDielectricReflection:
+      return true;
+    default:
+      // reflections on the LUT surfaces
+      return status >= PolishedLumirrorAirReflection && status <= GroundVM2000GlueReflection;
+  }
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhotonLimits::PhotonLimits() : G4VAccumulable("PhotonLimits")
+{
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhotonLimits::~PhotonLimits() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonLimits::BeginOfRun()
+{
+  fActive = fMaxTime > 0. || fMaxReflections > 0 || fMaxLength > 0.;
+  fNofReflections = 0;
+
+  // the boundary process is thread-local
+  fBoundary = nullptr;
+  if (fMaxReflections <= 0) return;
+  auto processManager = G4OpticalPhoton::Definition()->GetProcessManager();
+  if (processManager) {
+    fBoundary = dynamic_cast<const G4OpBoundaryProcess*>(processManager->GetProcess("OpBoundary"));
+  }
+  if (!fBoundary) {
+    G4ExceptionDescription ed;
+    ed << "No optical boundary process: the reflection limit is ignored.";
+    G4Exception("PhotonLimits::BeginOfRun()", "B1Photon001", JustWarning, ed);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonLimits::Check(const G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+  if (track->GetCurrentStepNumber() == 1) {
+    fNofReflections = 0;
+    fNofPhotons += 1.;
+  }
+  if (fBoundary && step->GetPostStepPoint()->GetStepStatus() == fGeomBoundary
+      && IsReflection(fBoundary->GetStatus()))
+  {
+    ++fNofReflections;
+  }
+  // absorbed or detected in this step
+  if (track->GetTrackStatus() != fAlive) return;
+
+  Reason reason;
+  if (fMaxTime > 0. && track->GetGlobalTime() > fMaxTime) {
+    reason = kTime;
+  }
+  else if (fBoundary && fNofReflections > fMaxReflections) {
+    reason = kReflections;
+  }
+  else if (fMaxLength > 0. && track->GetTrackLength() > fMaxLength) {
+    reason = kLength;
+  }
+  else {
+    return;
+  }
+  track->SetTrackStatus(fStopAndKill);
+  fNofKilled[reason] += 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonLimits::Merge(const G4VAccumulable& other)
+{
+  const auto& otherLimits = static_cast<const PhotonLimits&>(other);
+  fNofPhotons += otherLimits.fNofPhotons;
+  for (G4int i = 0; i < kNofReasons; ++i) {
+    fNofKilled[i] += otherLimits.fNofKilled[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonLimits::Reset()
+{
+  fNofPhotons = 0.;
+  fNofKilled.fill(0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonLimits::Print(G4PrintOptions) const
+{
+  auto percent = [this](G4double n) { return (fNofPhotons > 0.) ? 100. * n / fNofPhotons : 0.; };
+
+  G4cout << G4endl << " Optical photon limits: " << fNofPhotons << " photons tracked"
+         << G4endl;
+  if (fMaxTime > 0.) {
+    G4cout << "   global time > " << fMaxTime / ns << " ns: " << fNofKilled[kTime]
+           << " killed (" << percent(fNofKilled[kTime]) << " %)" << G4endl;
+  }
+  if (fMaxReflections > 0) {
+    G4cout << "   reflections > " << fMaxReflections << ": " << fNofKilled[kReflections]
+           << " killed (" << percent(fNofKilled[kReflections]) << " %)" << G4endl;
+  }
+  if (fMaxLength > 0.) {
+    G4cout << "   path length > " << fMaxLength / m << " m: " << fNofKilled[kLength]
+           << " killed (" << percent(fNofKilled[kLength]) << " %)" << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonLimits::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/photonLimits/",
+                                                    "Kill limits of the optical photons");
+
+  fMessenger->DeclarePropertyWithUnit("maxTime", "ns", fMaxTime)
+    .SetGuidance("Kill the optical photons after this global time (0 = no limit),")
+    .SetGuidance("e.g. the end of the trigger window.")
+    .SetParameterName("time", false)
+    .SetRange("time>=0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("maxReflections", fMaxReflections)
+    .SetGuidance("Kill the optical photons after this number of reflections on")
+    .SetGuidance("the volume boundaries (0 = no limit).")
+    .SetParameterName("nofReflections", false)
+    .SetRange("nofReflections>=0")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclarePropertyWithUnit("maxLength", "m", fMaxLength)
+    .SetGuidance("Kill the optical photons after this path length (0 = no limit).")
+    .SetParameterName("length", false)
+    .SetRange("length>=0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
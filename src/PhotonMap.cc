@@ -0,0 +1,326 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PhotonMap.cc
+/// \brief Implementation of the B1::PhotonMap class
+
+#include "PhotonMap.hh"
+
+#include "G4AutoLock.hh"
+#include "G4Exception.hh"
+#include "G4PhysicalConstants.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace B1
+{
+
+namespace
+{
+constexpr char kMagic[8] = {'B', '1', 'P', 'H', 'M', 'A', 'P', 0};
+constexpr std::uint32_t kVersion = 1;
+
+G4Mutex loadMutex = G4MUTEX_INITIALIZER;
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhotonMap::PhotonMap(G4int nofR, G4int nofPhi, G4int nofZ, G4int nofFold, G4int nofPMTs,
+                     G4int nofTimeBins, G4double rMax, G4double zMin, G4double zMax,
+                     G4double tMax)
+{
+  std::memcpy(fHeader.magic, kMagic, sizeof(kMagic));
+  fHeader.version = kVersion;
+  fHeader.nofR = nofR;
+  fHeader.nofPhi = nofPhi;
+  fHeader.nofZ = nofZ;
+  fHeader.nofFold = nofFold;
+  fHeader.nofPMTs = nofPMTs;
+  fHeader.nofTimeBins = nofTimeBins;
+  fHeader.rMax = rMax;
+  fHeader.zMin = zMin;
+  fHeader.zMax = zMax;
+  fHeader.tMax = tMax;
+  fSector = twopi / nofFold;
+
+  std::size_t nofCells = std::size_t(nofR) * nofPhi * nofZ;
+  fLaunched.assign(nofCells, 0);
+  fProbabilities.assign(nofCells * nofPMTs, 0.f);
+  fTimeCDFs.assign(nofCells * nofPMTs * nofTimeBins, 0.f);
+  fCumulative.assign(nofCells * nofPMTs, 0.f);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::shared_ptr<const PhotonMap> PhotonMap::Load(const G4String& fileName)
+{
+  static std::map<G4String, std::shared_ptr<const PhotonMap>> maps;
+
+  G4AutoLock lock(&loadMutex);
+  auto it = maps.find(fileName);
+  if (it != maps.end()) return it->second;
+
+  auto map = std::make_shared<PhotonMap>();
+  if (!map->Read(fileName)) return nullptr;
+  maps[fileName] = map;
+  return map;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhotonMap::Read(const G4String& fileName)
+{
+  std::ifstream in(fileName, std::ios::binary);
+  Header header;
+  if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header))
+      || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+  {
+    G4ExceptionDescription ed;
+    ed << "Cannot read the photon map " << fileName << ".";
+    G4Exception("PhotonMap::Read()", "B1PhotonMap001", JustWarning, ed);
+    return false;
+  }
+  if (header.version != kVersion) {
+    G4ExceptionDescription ed;
+    ed << "Photon map " << fileName << " has version " << header.version << ", expected "
+       << kVersion << ".";
+    G4Exception("PhotonMap::Read()", "B1PhotonMap002", JustWarning, ed);
+    return false;
+  }
+
+  // check the dimensions against the file size before allocating, so that
+  // a corrupt header cannot request an arbitrary amount of memory
+  auto dataStart = in.tellg();
+  in.seekg(0, std::ios::end);
+  auto dataSize = static_cast<std::uint64_t>(in.tellg() - dataStart);
+  in.seekg(dataStart);
+  // (the products are first bounded in floating point, where they cannot overflow)
+  G4double cellsBound = G4double(header.nofR) * header.nofPhi * header.nofZ;
+  G4double entriesBound = cellsBound * header.nofPMTs * (1. + header.nofTimeBins);
+  G4bool valid = header.nofR > 0 && header.nofPhi > 0 && header.nofZ > 0 && header.nofFold > 0
+                 && header.nofPMTs > 0 && header.nofTimeBins > 0
+                 && cellsBound * sizeof(std::uint64_t) + entriesBound * sizeof(G4float)
+                      <= G4double(dataSize)
+                 && header.rMax > 0. && header.zMax > header.zMin && header.tMax > 0.;
+  if (valid) {
+    std::uint64_t nofCells = std::uint64_t(header.nofR) * header.nofPhi * header.nofZ;
+    std::uint64_t nofEntries = nofCells * header.nofPMTs;
+    std::uint64_t expected = nofCells * sizeof(std::uint64_t)
+                             + nofEntries * (1 + header.nofTimeBins) * sizeof(G4float);
+    valid = expected == dataSize;
+  }
+  if (!valid) {
+    G4ExceptionDescription ed;
+    ed << "Photon map " << fileName << " has an invalid header: " << header.nofR << " x "
+       << header.nofPhi << " x " << header.nofZ << " cells, fold " << header.nofFold << ", "
+       << header.nofPMTs << " PMTs, " << header.nofTimeBins << " time bins, for " << dataSize
+       << " bytes of data.";
+    G4Exception("PhotonMap::Read()", "B1PhotonMap005", JustWarning, ed);
+    return false;
+  }
+
+  *this = PhotonMap(header.nofR, header.nofPhi, header.nofZ, header.nofFold, header.nofPMTs,
+                    header.nofTimeBins, header.rMax, header.zMin, header.zMax, header.tMax);
+  in.read(reinterpret_cast<char*>(fLaunched.data()), fLaunched.size() * sizeof(std::uint64_t));
+  in.read(reinterpret_cast<char*>(fProbabilities.data()),
+          fProbabilities.size() * sizeof(G4float));
+  in.read(reinterpret_cast<char*>(fTimeCDFs.data()), fTimeCDFs.size() * sizeof(G4float));
+  if (!in) {
+    G4ExceptionDescription ed;
+    ed << "Photon map " << fileName << " is truncated.";
+    G4Exception("PhotonMap::Read()", "B1PhotonMap003", JustWarning, ed);
+    return false;
+  }
+
+  BuildCumulative();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhotonMap::Write(const G4String& fileName) const
+{
+  // write to a temporary file and rename, so that a map is never half-written
+  G4String tmpName = fileName + ".tmp";
+  std::ofstream out(tmpName, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&fHeader), sizeof(fHeader));
+  out.write(reinterpret_cast<const char*>(fLaunched.data()),
+            fLaunched.size() * sizeof(std::uint64_t));
+  out.write(reinterpret_cast<const char*>(fProbabilities.data()),
+            fProbabilities.size() * sizeof(G4float));
+  out.write(reinterpret_cast<const char*>(fTimeCDFs.data()), fTimeCDFs.size() * sizeof(G4float));
+  out.close();
+  if (!out || std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    G4ExceptionDescription ed;
+    ed << "Cannot write the photon map " << fileName << ".";
+    G4Exception("PhotonMap::Write()", "B1PhotonMap004", JustWarning, ed);
+    return false;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PhotonMap::GetCell(const G4ThreeVector& position, G4int& sector) const
+{
+  G4double r = position.perp();
+  G4double z = position.z();
+  if (r >= fHeader.rMax || z < fHeader.zMin || z >= fHeader.zMax) return -1;
+
+  G4double phi = position.phi();
+  if (phi < 0.) phi += twopi;
+  sector = std::min(static_cast<G4int>(phi / fSector), static_cast<G4int>(fHeader.nofFold) - 1);
+  G4double phiInSector = phi - sector * fSector;
+
+  auto iR = static_cast<G4int>(r / fHeader.rMax * fHeader.nofR);
+  auto iPhi = std::min(static_cast<G4int>(phiInSector / fSector * fHeader.nofPhi),
+                       static_cast<G4int>(fHeader.nofPhi) - 1);
+  auto iZ = static_cast<G4int>((z - fHeader.zMin) / (fHeader.zMax - fHeader.zMin) * fHeader.nofZ);
+  return (iZ * fHeader.nofPhi + iPhi) * fHeader.nofR + iR;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMap::GetCellBins(G4int cell, G4int& iR, G4int& iPhi, G4int& iZ) const
+{
+  iR = cell % fHeader.nofR;
+  iPhi = (cell / fHeader.nofR) % fHeader.nofPhi;
+  iZ = cell / (fHeader.nofR * fHeader.nofPhi);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector PhotonMap::GetCellCentre(G4int cell) const
+{
+  G4int iR, iPhi, iZ;
+  GetCellBins(cell, iR, iPhi, iZ);
+  G4double r = (iR + 0.5) * fHeader.rMax / fHeader.nofR;
+  G4double phi = (iPhi + 0.5) * fSector / fHeader.nofPhi;
+  G4double z = fHeader.zMin + (iZ + 0.5) * (fHeader.zMax - fHeader.zMin) / fHeader.nofZ;
+  return {r * std::cos(phi), r * std::sin(phi), z};
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PhotonMap::SamplePMT(G4int cell, G4double u) const
+{
+  const G4float* cumulative = &fCumulative[std::size_t(cell) * fHeader.nofPMTs];
+  const G4float* end = cumulative + fHeader.nofPMTs;
+  auto it = std::upper_bound(cumulative, end, static_cast<G4float>(u));
+  return (it == end) ? -1 : static_cast<G4int>(it - cumulative);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PhotonMap::SampleTime(G4int cell, G4int pmt, G4double u) const
+{
+  const std::size_t nofBins = fHeader.nofTimeBins;
+  const G4float* cdf = &fTimeCDFs[(std::size_t(cell) * fHeader.nofPMTs + pmt) * nofBins];
+  auto it = std::upper_bound(cdf, cdf + nofBins, static_cast<G4float>(u));
+  if (it == cdf + nofBins) return fHeader.tMax;
+
+  // linear interpolation within the bin
+  auto bin = static_cast<std::size_t>(it - cdf);
+  G4double low = (bin > 0) ? cdf[bin - 1] : 0.;
+  G4double frac = (*it > low) ? (u - low) / (*it - low) : 0.5;
+  return (bin + frac) * fHeader.tMax / nofBins;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PhotonMap::RotatePMT(G4int pmt, G4int sector) const
+{
+  const G4int nofFold = fHeader.nofFold;
+  return (pmt / nofFold) * nofFold + (pmt % nofFold + sector) % nofFold;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMap::SetCell(G4int cell, std::uint64_t nofLaunched, const G4double* detected,
+                        const G4double* tofHistograms)
+{
+  const std::size_t nofPMTs = fHeader.nofPMTs;
+  const std::size_t nofBins = fHeader.nofTimeBins;
+  fLaunched[cell] = nofLaunched;
+  for (std::size_t pmt = 0; pmt < nofPMTs; ++pmt) {
+    fProbabilities[cell * nofPMTs + pmt] =
+      nofLaunched > 0 ? static_cast<G4float>(detected[pmt] / nofLaunched) : 0.f;
+
+    const G4double* histogram = tofHistograms + pmt * nofBins;
+    G4float* cdf = &fTimeCDFs[(cell * nofPMTs + pmt) * nofBins];
+    G4double sum = 0.;
+    for (std::size_t bin = 0; bin < nofBins; ++bin) sum += histogram[bin];
+    G4double running = 0.;
+    for (std::size_t bin = 0; bin < nofBins; ++bin) {
+      running += histogram[bin];
+      cdf[bin] = sum > 0. ? static_cast<G4float>(running / sum) : 1.f;
+    }
+  }
+  BuildCumulative(cell);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMap::CopyCells(const PhotonMap& source, G4int firstCell)
+{
+  const std::size_t first = firstCell;
+  const std::size_t nofPMTs = fHeader.nofPMTs;
+  const std::size_t nofBins = fHeader.nofTimeBins;
+  std::copy(source.fLaunched.begin(), source.fLaunched.end(), fLaunched.begin() + first);
+  std::copy(source.fProbabilities.begin(), source.fProbabilities.end(),
+            fProbabilities.begin() + first * nofPMTs);
+  std::copy(source.fTimeCDFs.begin(), source.fTimeCDFs.end(),
+            fTimeCDFs.begin() + first * nofPMTs * nofBins);
+  for (G4int cell = 0; cell < source.GetNofCells(); ++cell) BuildCumulative(firstCell + cell);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMap::BuildCumulative()
+{
+  for (G4int cell = 0; cell < GetNofCells(); ++cell) BuildCumulative(cell);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMap::BuildCumulative(G4int cell)
+{
+  const std::size_t nofPMTs = fHeader.nofPMTs;
+  G4float running = 0.f;
+  for (std::size_t pmt = 0; pmt < nofPMTs; ++pmt) {
+    running += fProbabilities[cell * nofPMTs + pmt];
+    fCumulative[cell * nofPMTs + pmt] = running;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
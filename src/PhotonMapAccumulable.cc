@@ -0,0 +1,111 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PhotonMapAccumulable.cc
+/// \brief Implementation of the B1::PhotonMapAccumulable class
+
+#include "PhotonMapAccumulable.hh"
+
+#include "PhotonBuffer.hh"
+#include "PhotonMapGenerator.hh"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhotonMapAccumulable::PhotonMapAccumulable() : G4VAccumulable("PhotonMap") {}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapAccumulable::Fill(G4int cell, G4int nofLaunched, const PhotonBuffer& photons)
+{
+  fLaunched[cell] += nofLaunched;
+
+  const std::size_t nofPhotons = photons.Size();
+  const G4double* times = photons.GetTimes().data();
+  const G4int* pmtIDs = photons.GetPMTIDs().data();
+  G4double* detected = &fDetected[cell * fNofPMTs];
+  G4double* histograms = &fTimeHistograms[cell * fNofPMTs * fNofTimeBins];
+  for (std::size_t i = 0; i < nofPhotons; ++i) {
+    if (pmtIDs[i] < 0 || pmtIDs[i] >= fNofPMTs) continue;
+    detected[pmtIDs[i]] += 1.;
+    // photons later than the map time range count as detected, but do not
+    // enter the time-of-flight distribution
+    auto bin = static_cast<G4int>(times[i] * fInvTimeBinWidth);
+    if (bin < fNofTimeBins) histograms[pmtIDs[i] * fNofTimeBins + bin] += 1.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapAccumulable::Merge(const G4VAccumulable& other)
+{
+  const auto& otherMap = static_cast<const PhotonMapAccumulable&>(other);
+  std::transform(fLaunched.begin(), fLaunched.end(), otherMap.fLaunched.begin(),
+                 fLaunched.begin(), std::plus<>());
+  std::transform(fDetected.begin(), fDetected.end(), otherMap.fDetected.begin(),
+                 fDetected.begin(), std::plus<>());
+  std::transform(fTimeHistograms.begin(), fTimeHistograms.end(),
+                 otherMap.fTimeHistograms.begin(), fTimeHistograms.begin(), std::plus<>());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapAccumulable::Reset()
+{
+  // sized for the slice of the current generation run, empty otherwise
+  const PhotonMapGenerator* generator = PhotonMapGenerator::Instance();
+  G4int nofCells = 0;
+  if (generator && PhotonMapGenerator::IsActive()) {
+    nofCells = generator->GetNofSliceCells();
+    fNofPMTs = generator->GetNofPMTs();
+    fNofTimeBins = generator->GetNofTimeBins();
+    fInvTimeBinWidth = fNofTimeBins / generator->GetTimeMax();
+  }
+
+  fLaunched.assign(nofCells, 0.);
+  fDetected.assign(std::size_t(nofCells) * fNofPMTs, 0.);
+  fTimeHistograms.assign(std::size_t(nofCells) * fNofPMTs * fNofTimeBins, 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapAccumulable::Print(G4PrintOptions) const
+{
+  G4double launched = std::accumulate(fLaunched.begin(), fLaunched.end(), 0.);
+  G4double detected = std::accumulate(fDetected.begin(), fDetected.end(), 0.);
+  G4cout << GetName() << ": " << GetNofCells() << " cells, " << launched
+         << " photons launched, " << detected << " detected" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,324 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PhotonMapGenerator.cc
+/// \brief Implementation of the B1::PhotonMapGenerator class
+
+#include "PhotonMapGenerator.hh"
+
+#include "DetectorConstruction.hh"
+#include "PhotonMap.hh"
+#include "PhotonMapAccumulable.hh"
+
+#include "G4Event.hh"
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhotonMapGenerator::PhotonMapGenerator()
+  : fTimeMax(100. * ns), fEnergy(2.95 * eV)  // 420 nm, near the Bi-MSB emission peak
+{
+  fgInstance = this;
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhotonMapGenerator::~PhotonMapGenerator()
+{
+  fgInstance = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapGenerator::GeneratePrimaries(G4Event* event) const
+{
+  // cell of sector 0 in the target frame
+  G4int cell = GetSliceCell(event->GetEventID());
+  G4int iR = cell % fNofR;
+  G4int iPhi = cell / fNofR;
+  G4double rBin = fRMax / fNofR;
+  G4double phiBin = twopi / fNofFold / fNofPhi;
+  G4double zBin = (fZMax - fZMin) / fNofZ;
+  G4double r2Low = std::pow(iR * rBin, 2);
+  G4double r2High = std::pow((iR + 1) * rBin, 2);
+  G4double zLow = fZMin + fSlice * zBin;
+
+  const G4ParticleDefinition* opticalPhoton = G4OpticalPhoton::Definition();
+  for (G4int i = 0; i < fPhotonsPerEvent; ++i) {
+    // uniform in the cell volume
+    G4double r = std::sqrt(r2Low + G4UniformRand() * (r2High - r2Low));
+    G4double phi = (iPhi + G4UniformRand()) * phiBin;
+    G4double z = zLow + G4UniformRand() * zBin;
+
+    // isotropic, with a random linear polarisation
+    G4double cosTheta = 2. * G4UniformRand() - 1.;
+    G4double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+    G4double phiDirection = twopi * G4UniformRand();
+    G4ThreeVector direction(sinTheta * std::cos(phiDirection),
+                            sinTheta * std::sin(phiDirection), cosTheta);
+    G4ThreeVector e1 = direction.orthogonal().unit();
+    G4ThreeVector e2 = direction.cross(e1);
+    G4double angle = twopi * G4UniformRand();
+    G4ThreeVector polarisation = std::cos(angle) * e1 + std::sin(angle) * e2;
+
+    auto particle = new G4PrimaryParticle(opticalPhoton);
+    particle->SetKineticEnergy(fEnergy);
+    particle->SetMomentumDirection(direction);
+    particle->SetPolarization(polarisation);
+
+    auto vertex = new G4PrimaryVertex(G4ThreeVector(r * std::cos(phi), r * std::sin(phi), z), 0.);
+    vertex->SetPrimary(particle);
+    event->AddPrimaryVertex(vertex);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapGenerator::EndOfSlice(const PhotonMapAccumulable& accumulable)
+{
+  G4double zBin = (fZMax - fZMin) / fNofZ;
+  PhotonMap slice(fNofR, fNofPhi, 1, fNofFold, fNofPMTs, fNofTimeBins, fRMax,
+                  fZMin + fSlice * zBin, fZMin + (fSlice + 1) * zBin, fTimeMax);
+  for (G4int cell = 0; cell < accumulable.GetNofCells(); ++cell) {
+    auto launched = static_cast<std::uint64_t>(accumulable.GetLaunched(cell));
+    slice.SetCell(cell, launched, accumulable.GetDetected(cell),
+                  accumulable.GetTimeHistograms(cell));
+  }
+  if (slice.Write(GetSliceFileName(fSlice))) {
+    G4cout << " Photon map slice " << fSlice << " written to " << GetSliceFileName(fSlice)
+           << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapGenerator::Generate()
+{
+  UpdateGeometry();
+
+  G4int lastSlice = (fLastSlice < 0) ? fNofZ - 1 : std::min(fLastSlice, fNofZ - 1);
+  G4int nofEvents = GetNofSliceCells() * fEventsPerCell;
+
+  auto runManager = G4RunManager::GetRunManager();
+  fgActive.store(true, std::memory_order_release);
+  for (fSlice = fFirstSlice; fSlice <= lastSlice; ++fSlice) {
+    if (IsSliceDone(fSlice)) {
+      G4cout << " Photon map slice " << fSlice << " already done, skipped" << G4endl;
+      continue;
+    }
+    G4cout << " Generating photon map slice " << fSlice << " of " << fNofZ << ": "
+           << nofEvents << " events of " << fPhotonsPerEvent << " photons" << G4endl;
+    runManager->BeamOn(nofEvents);
+  }
+  fgActive.store(false, std::memory_order_release);
+
+  Assemble();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapGenerator::Assemble()
+{
+  UpdateGeometry();
+  for (G4int slice = 0; slice < fNofZ; ++slice) {
+    if (!IsSliceDone(slice)) {
+      G4cout << " Photon map " << fFileName << " not assembled: slice " << slice
+             << " is missing" << G4endl;
+      return;
+    }
+  }
+
+  PhotonMap map(fNofR, fNofPhi, fNofZ, fNofFold, fNofPMTs, fNofTimeBins, fRMax, fZMin, fZMax,
+                fTimeMax);
+  for (G4int slice = 0; slice < fNofZ; ++slice) {
+    PhotonMap sliceMap;
+    if (!sliceMap.Read(GetSliceFileName(slice))) return;
+    map.CopyCells(sliceMap, slice * GetNofSliceCells());
+  }
+  if (map.Write(fFileName)) {
+    G4cout << " Photon map written to " << fFileName << ": " << map.GetNofCells()
+           << " cells, " << fNofPMTs << " PMTs" << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapGenerator::UpdateGeometry()
+{
+  const auto detConstruction = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  fRMax = detConstruction->GetTargetRadius();
+  fZMin = -detConstruction->GetTargetHalfLength();
+  fZMax = detConstruction->GetTargetHalfLength();
+  fNofFold = detConstruction->GetPMTSymmetryFold();
+  fNofPMTs = detConstruction->GetNofPMTs();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhotonMapGenerator::IsSliceDone(G4int slice) const
+{
+  G4String fileName = GetSliceFileName(slice);
+  if (!std::ifstream(fileName).good()) return false;
+
+  // a slice of another grid is regenerated
+  PhotonMap sliceMap;
+  if (sliceMap.Read(fileName) && sliceMap.GetNofR() == fNofR && sliceMap.GetNofPhi() == fNofPhi
+      && sliceMap.GetNofZ() == 1 && sliceMap.GetNofFold() == fNofFold
+      && sliceMap.GetNofPMTs() == fNofPMTs && sliceMap.GetNofTimeBins() == fNofTimeBins
+      && sliceMap.GetTimeMax() == fTimeMax)
+  {
+    return true;
+  }
+
+  G4ExceptionDescription ed;
+  ed << "Photon map slice " << fileName << " does not match the current grid; "
+     << "it will be regenerated.";
+  G4Exception("PhotonMapGenerator::IsSliceDone()", "B1PhotonMap101", JustWarning, ed);
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PhotonMapGenerator::GetSliceFileName(G4int slice) const
+{
+  return fFileName + ".slice" + std::to_string(slice);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapGenerator::DefineCommands()
+{
+  fMessenger =
+    std::make_unique<G4GenericMessenger>(this, "/B1/photonMap/", "Photon map generation");
+
+  fMessenger->DeclareProperty("nofR", fNofR)
+    .SetGuidance("Number of radial bins of the map grid.")
+    .SetParameterName("n", false)
+    .SetRange("n>0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("nofPhi", fNofPhi)
+    .SetGuidance("Number of phi bins within one sector of the PMT ring.")
+    .SetParameterName("n", false)
+    .SetRange("n>0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("nofZ", fNofZ)
+    .SetGuidance("Number of z bins, i.e. of slices, of the map grid.")
+    .SetParameterName("n", false)
+    .SetRange("n>0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("nofTimeBins", fNofTimeBins)
+    .SetGuidance("Number of bins of the time-of-flight distributions.")
+    .SetParameterName("n", false)
+    .SetRange("n>0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("timeMax", "ns", fTimeMax)
+    .SetGuidance("Upper edge of the time-of-flight distributions.")
+    .SetParameterName("time", false)
+    .SetRange("time>0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("energy", "eV", fEnergy)
+    .SetGuidance("Energy of the launched optical photons.")
+    .SetParameterName("energy", false)
+    .SetRange("energy>0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("photonsPerEvent", fPhotonsPerEvent)
+    .SetGuidance("Number of photons launched in an event.")
+    .SetParameterName("n", false)
+    .SetRange("n>0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("eventsPerCell", fEventsPerCell)
+    .SetGuidance("Number of events per grid cell.")
+    .SetParameterName("n", false)
+    .SetRange("n>0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("fileName", fFileName)
+    .SetGuidance("Name of the map file; the slices are written to <fileName>.slice<k>.")
+    .SetParameterName("fileName", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("firstSlice", fFirstSlice)
+    .SetGuidance("First z-slice generated by this process.")
+    .SetParameterName("slice", false)
+    .SetRange("slice>=0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("lastSlice", fLastSlice)
+    .SetGuidance("Last z-slice generated by this process (-1 = the last one).")
+    .SetParameterName("slice", false)
+    .SetRange("slice>=-1")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("generate", &PhotonMapGenerator::Generate)
+    .SetGuidance("Generate the missing slices of the selected range, then assemble")
+    .SetGuidance("the map if all slices are present.")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("assemble", &PhotonMapGenerator::Assemble)
+    .SetGuidance("Assemble the map from the slice files of all processes.")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,144 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PhotonMapModel.cc
+/// \brief Implementation of the B1::PhotonMapModel class
+
+#include "PhotonMapModel.hh"
+
+#include "PMTSD.hh"
+#include "PhotonInformation.hh"
+#include "PhotonMap.hh"
+#include "PhotonMapGenerator.hh"
+
+#include "G4FastStep.hh"
+#include "G4Exception.hh"
+#include "G4FastTrack.hh"
+#include "G4GenericMessenger.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4Threading.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhotonMapModel::PhotonMapModel(const G4String& name, G4Region* envelope, PMTSD* pmtSD)
+  : G4VFastSimulationModel(name, envelope), fPMTSD(pmtSD)
+{
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhotonMapModel::~PhotonMapModel() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhotonMapModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return &particle == G4OpticalPhoton::Definition();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhotonMapModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  // only photons emitted in the target, at their first step; the map
+  // generation runs track all photons
+  return fEnabled && fMap && !PhotonMapGenerator::IsActive()
+         && fastTrack.GetPrimaryTrack()->GetTrackLength() == 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+  fastStep.KillPrimaryTrack();
+
+  G4int sector = 0;
+  G4int cell = fMap->GetCell(fastTrack.GetPrimaryTrackLocalPosition(), sector);
+  if (cell < 0) return;
+
+  G4int pmt = fMap->SamplePMT(cell, G4UniformRand());
+  if (pmt < 0) return;
+
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  G4double time = track->GetGlobalTime() + fMap->SampleTime(cell, pmt, G4UniformRand());
+  fPMTSD->RecordPhoton(fMap->RotatePMT(pmt, sector), time, track->GetTotalEnergy(),
+                       track->GetTrackID(),
+                       static_cast<const PhotonInformation*>(track->GetUserInformation()));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapModel::LoadMap(const G4String& fileName)
+{
+  auto map = PhotonMap::Load(fileName);
+  if (!map) return;
+
+  // the map must have been generated for the current PMT array
+  if (map->GetNofPMTs() != fPMTSD->GetNofPMTs()) {
+    G4ExceptionDescription ed;
+    ed << "Photon map " << fileName << " has " << map->GetNofPMTs()
+       << " PMTs, the geometry has " << fPMTSD->GetNofPMTs() << "; map not loaded.";
+    G4Exception("PhotonMapModel::LoadMap()", "B1FastSim001", JustWarning, ed);
+    return;
+  }
+
+  fMap = map;
+  fEnabled = true;
+  if (G4Threading::IsMasterThread()) {
+    G4cout << " Photon map " << fileName << " loaded: " << fMap->GetNofCells() << " cells, "
+           << fMap->GetNofPMTs() << " PMTs" << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhotonMapModel::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/fastsim/",
+                                                    "Parametrised optical model of the target");
+
+  fMessenger->DeclareProperty("enable", fEnabled)
+    .SetGuidance("Use the photon map for the optical photons emitted in the target.")
+    .SetGuidance("Set to false for full optical tracking.")
+    .SetParameterName("enable", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareMethod("mapFile", &PhotonMapModel::LoadMap)
+    .SetGuidance("Load the photon map file and enable the model.")
+    .SetParameterName("fileName", false)
+    .SetStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,89 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/PhysicsListFactory.cc
+/// \brief Implementation of the B1::PhysicsListFactory class
+
+#include "PhysicsListFactory.hh"
+
+#include "QBBC.hh"
+#include "SlimPhysicsList.hh"
+
+#include "G4FastSimulationPhysics.hh"
+#include "G4OpticalParameters.hh"
+#include "G4OpticalPhysics.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4VModularPhysicsList.hh"
+
+#include <cstdlib>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PhysicsListFactory::GetDefaultName()
+{
+  const char* name = std::getenv("B1_PHYSICS_LIST");
+  return (name && *name) ? name : "QBBC";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VModularPhysicsList* PhysicsListFactory::Create(const G4String& name)
+{
+  G4VModularPhysicsList* physicsList = nullptr;
+  if (name == "QBBC") {
+    physicsList = new QBBC;
+  }
+  else if (name == "slim") {
+    physicsList = new SlimPhysicsList;
+  }
+  else {
+    return nullptr;
+  }
+  physicsList->SetVerboseLevel(1);
+
+  G4OpticalPhysics* opticalPhysics = new G4OpticalPhysics();
+  // photons detected on the photocathode surface are passed to the PMT SD
+  G4OpticalParameters::Instance()->SetBoundaryInvokeSD(true);
+  physicsList->RegisterPhysics(opticalPhysics);
+  // fast simulation of the optical photons (PhotonMapModel, /B1/fastsim/)
+  auto fastSimulationPhysics = new G4FastSimulationPhysics();
+  fastSimulationPhysics->ActivateFastSimulation("opticalphoton");
+  physicsList->RegisterPhysics(fastSimulationPhysics);
+  // user limits of the detector regions (G4UserSpecialCuts, /B1/region/),
+  // for the neutral particles and optical photons as well
+  auto stepLimiterPhysics = new G4StepLimiterPhysics();
+  stepLimiterPhysics->SetApplyToAll(true);
+  physicsList->RegisterPhysics(stepLimiterPhysics);
+
+  return physicsList;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
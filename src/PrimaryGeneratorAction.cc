@@ -1,11 +1,19 @@
 #include "PrimaryGeneratorAction.hh"
+
+#include "DetectorConstruction.hh"
+#include "IBDGenerator.hh"
+#include "PhiloxEngine.hh"
+#include "PhotonMapGenerator.hh"
+
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Tubs.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
+#include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Event.hh"
+#include "G4GenericMessenger.hh"
 #include "Randomize.hh"
 
 namespace B1
@@ -20,35 +28,44 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
       G4ParticleTable::GetParticleTable()->FindParticle("e+");
   fParticleGun->SetParticleDefinition(particle);
   fParticleGun->SetParticleEnergy(3.0 * MeV);
+
+  DefineCommands();
 }
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
   delete fParticleGun;
+  // the engine of the thread must not outlive this action
+  if (fEngine && G4Random::getTheEngine() == fEngine.get()) {
+    G4Random::setTheEngine(fDefaultEngine);
+  }
 }
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
 {
-  G4double vessel_radius = 600 * mm;
-  G4double pmma_thickness = 10 * mm;
-  G4double vessel_height = 700 * mm;
+  // first, as the random numbers of the event come from its stream
+  SetEventStream(event);
 
-  G4double inner_radius = 0.0;
-  G4double outer_radius = vessel_radius - pmma_thickness;
-  G4double half_height = vessel_height / 2.0;
+  // optical photons of the photon map generation runs
+  if (PhotonMapGenerator::IsActive()) {
+    PhotonMapGenerator::Instance()->GeneratePrimaries(event);
+    return;
+  }
 
-  G4double r = outer_radius * std::sqrt(G4UniformRand());
-  G4double phi = 2. * CLHEP::pi * G4UniformRand();
-  G4double z = (2. * G4UniformRand() - 1.) * half_height;
+  // vertex and direction, in a single call to the engine
+  G4double u[5];
+  G4Random::getTheEngine()->flatArray(IsIBDMode() ? 3 : 5, u);
 
-  G4double x = r * std::cos(phi);
-  G4double y = r * std::sin(phi);
+  if (IsIBDMode()) {
+    IBDGenerator::Instance().GeneratePrimaryVertex(event, SampleVertex(u), fNeutrinoDirection);
+    return;
+  }
 
-  fParticleGun->SetParticlePosition(G4ThreeVector(x, y, z));
+  fParticleGun->SetParticlePosition(SampleVertex(u));
 
-  G4double costheta = 2. * G4UniformRand() - 1.;
+  G4double costheta = 2. * u[3] - 1.;
   G4double sintheta = std::sqrt(1. - costheta * costheta);
-  G4double phi_dir = 2. * CLHEP::pi * G4UniformRand();
+  G4double phi_dir = 2. * CLHEP::pi * u[4];
 
   G4double dx = sintheta * std::cos(phi_dir);
   G4double dy = sintheta * std::sin(phi_dir);
@@ -59,4 +76,110 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
   fParticleGun->GeneratePrimaryVertex(event);
 }
 
+G4ThreeVector PrimaryGeneratorAction::SampleVertex(const G4double* u) const
+{
+  // uniform in the Gd-LAB target, which follows the geometry parameters
+  const auto detConstruction = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  G4double outer_radius = detConstruction->GetTargetRadius();
+  G4double half_height = detConstruction->GetTargetHalfLength();
+
+  G4double r = outer_radius * std::sqrt(u[0]);
+  G4double phi = 2. * CLHEP::pi * u[1];
+  G4double z = (2. * u[2] - 1.) * half_height;
+
+  return G4ThreeVector(r * std::cos(phi), r * std::sin(phi), z);
+}
+
+void PrimaryGeneratorAction::SetEventStream(const G4Event* event)
+{
+  if (!fCounterBased) {
+    if (fEngine && G4Random::getTheEngine() == fEngine.get()) {
+      G4Random::setTheEngine(fDefaultEngine);
+    }
+    return;
+  }
+
+  // installed here, on the thread of the events, in all run manager types
+  if (!fEngine) fEngine = std::make_unique<PhiloxEngine>();
+  if (G4Random::getTheEngine() != fEngine.get()) {
+    fDefaultEngine = G4Random::getTheEngine();
+    G4Random::setTheEngine(fEngine.get());
+  }
+  // replaces the seeds given to the worker thread for this event; the
+  // event IDs restart at every run, hence the run in the key
+  const G4int run = (fRunNumber >= 0) ? fRunNumber : fgRunID.load(std::memory_order_acquire);
+  const std::uint64_t key = static_cast<std::uint32_t>(fSeed)
+                            | (std::uint64_t(static_cast<std::uint32_t>(run)) << 32);
+  fEngine->SetStream(key, static_cast<std::uint64_t>(fFirstEvent) + event->GetEventID());
+}
+
+void PrimaryGeneratorAction::SetMode(const G4String& mode)
+{
+  fMode = mode;
+  // the IBD tables are built when the mode is selected, not in an event
+  if (IsIBDMode()) IBDGenerator::Instance();
+}
+
+void PrimaryGeneratorAction::SetNeutrinoDirection(G4ThreeVector direction)
+{
+  if (direction.mag2() == 0.) {
+    G4ExceptionDescription ed;
+    ed << "Null antineutrino direction; not changed.";
+    G4Exception("PrimaryGeneratorAction::SetNeutrinoDirection()", "B1Gun001", JustWarning, ed);
+    return;
+  }
+  fNeutrinoDirection = direction.unit();
+}
+
+void PrimaryGeneratorAction::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/gun/", "Primary generator");
+
+  fMessenger->DeclareMethod("mode", &PrimaryGeneratorAction::SetMode)
+    .SetGuidance("Primary generator: gun (the /gun/ particle, isotropic) or ibd")
+    .SetGuidance("(reactor-antineutrino inverse beta decay: e+ and neutron).")
+    .SetParameterName("mode", false)
+    .SetCandidates("gun ibd")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareMethod("ibdDirection", &PrimaryGeneratorAction::SetNeutrinoDirection)
+    .SetGuidance("Direction of flight of the reactor antineutrinos (ibd mode).")
+    .SetParameterName("direction", false)
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fRandomMessenger =
+    std::make_unique<G4GenericMessenger>(this, "/B1/random/", "Per-event random streams");
+
+  fRandomMessenger->DeclareProperty("counterBased", fCounterBased)
+    .SetGuidance("Draw the random numbers of every event from its own stream of a")
+    .SetGuidance("counter-based engine (Philox4x32-10), keyed by the seed and the")
+    .SetGuidance("run, and selected by the event number: the events do not depend")
+    .SetGuidance("on the threads.")
+    .SetParameterName("counterBased", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fRandomMessenger->DeclareProperty("seed", fSeed)
+    .SetGuidance("Seed of the per-event streams. The runs of a job differ by their")
+    .SetGuidance("run ID; jobs with the same seed repeat the same events.")
+    .SetParameterName("seed", false)
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fRandomMessenger->DeclareProperty("firstEvent", fFirstEvent)
+    .SetGuidance("Event number of the first event of the next runs, e.g. to split a")
+    .SetGuidance("run into jobs or to reproduce a single event with /run/beamOn 1.")
+    .SetParameterName("firstEvent", false)
+    .SetRange("firstEvent>=0")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fRandomMessenger->DeclareProperty("runNumber", fRunNumber)
+    .SetGuidance("Run in the key of the per-event streams of the next runs, to replay")
+    .SetGuidance("the events of an earlier run. -1 (default): the ID of the run.")
+    .SetParameterName("runNumber", true)
+    .SetDefaultValue("-1")
+    .SetRange("runNumber>=-1")
+    .SetStates(G4State_PreInit, G4State_Idle);
+}
+
 }  // namespace B1
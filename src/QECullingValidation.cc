@@ -0,0 +1,155 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/QECullingValidation.cc
+/// \brief Implementation of the B1::QECullingValidation class
+
+#include "QECullingValidation.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace B1
+{
+
+namespace
+{
+// histogram ranges; entries outside go to the edge bins
+const G4double kEnergyMin = 2.0 * eV;
+const G4double kEnergyMax = 3.6 * eV;
+const G4double kTimeMax = 200. * ns;
+
+template <std::size_t N>
+void FillBin(std::array<G4double, N>& histogram, G4double x, G4double xMin, G4double xMax)
+{
+  auto bin = static_cast<G4int>(std::floor((x - xMin) / (xMax - xMin) * N));
+  histogram[std::clamp(bin, 0, static_cast<G4int>(N) - 1)] += 1.;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+QECullingValidation::QECullingValidation() : G4VAccumulable("QECullingValidation") {}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QECullingValidation::Fill(G4double energy, G4double time, G4bool reference,
+                               G4bool culled)
+{
+  if (reference) {
+    FillBin(fEnergyReference, energy, kEnergyMin, kEnergyMax);
+    FillBin(fTimeReference, time, 0., kTimeMax);
+  }
+  if (culled) {
+    FillBin(fEnergyCulled, energy, kEnergyMin, kEnergyMax);
+    FillBin(fTimeCulled, time, 0., kTimeMax);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QECullingValidation::Merge(const G4VAccumulable& other)
+{
+  const auto& otherValidation = static_cast<const QECullingValidation&>(other);
+  for (G4int i = 0; i < kNofBins; ++i) {
+    fEnergyReference[i] += otherValidation.fEnergyReference[i];
+    fEnergyCulled[i] += otherValidation.fEnergyCulled[i];
+    fTimeReference[i] += otherValidation.fTimeReference[i];
+    fTimeCulled[i] += otherValidation.fTimeCulled[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QECullingValidation::Reset()
+{
+  fEnergyReference.fill(0.);
+  fEnergyCulled.fill(0.);
+  fTimeReference.fill(0.);
+  fTimeCulled.fill(0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double QECullingValidation::GetNofEntries() const
+{
+  return std::accumulate(fEnergyReference.begin(), fEnergyReference.end(), 0.)
+         + std::accumulate(fEnergyCulled.begin(), fEnergyCulled.end(), 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double QECullingValidation::Chi2(const Histogram& h1, const Histogram& h2, G4int& ndf)
+{
+  G4double n1 = std::accumulate(h1.begin(), h1.end(), 0.);
+  G4double n2 = std::accumulate(h2.begin(), h2.end(), 0.);
+  G4double chi2 = 0.;
+  ndf = -1;
+  if (n1 <= 0. || n2 <= 0.) return 0.;
+
+  G4double w1 = std::sqrt(n2 / n1);
+  G4double w2 = std::sqrt(n1 / n2);
+  for (G4int i = 0; i < kNofBins; ++i) {
+    if (h1[i] + h2[i] <= 0.) continue;
+    G4double d = w1 * h1[i] - w2 * h2[i];
+    chi2 += d * d / (h1[i] + h2[i]);
+    ++ndf;
+  }
+  return chi2;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QECullingValidation::Print(G4PrintOptions) const
+{
+  G4double nofReference = std::accumulate(fEnergyReference.begin(), fEnergyReference.end(), 0.);
+  G4double nofCulled = std::accumulate(fEnergyCulled.begin(), fEnergyCulled.end(), 0.);
+  G4int ndfEnergy = 0;
+  G4int ndfTime = 0;
+  G4double chi2Energy = Chi2(fEnergyReference, fEnergyCulled, ndfEnergy);
+  G4double chi2Time = Chi2(fTimeReference, fTimeCulled, ndfTime);
+
+  // the samples share the photons reaching the photocathodes, so the chi2
+  // is below that of independent samples; a value above ndf + 3 sigma
+  // means that the culling changes the spectra
+  auto verdict = [](G4double chi2, G4int ndf) {
+    return (ndf <= 0 || chi2 <= ndf + 3. * std::sqrt(2. * ndf)) ? "compatible" : "INCOMPATIBLE";
+  };
+
+  G4cout << G4endl << " QE culling validation: " << nofReference
+         << " photons detected with the QE at the photocathode, " << nofCulled
+         << " with the QE at birth" << G4endl << "   energy spectrum: chi2/ndf = " << chi2Energy
+         << "/" << ndfEnergy << " (" << verdict(chi2Energy, ndfEnergy) << ")" << G4endl
+         << "   time spectrum:   chi2/ndf = " << chi2Time << "/" << ndfTime << " ("
+         << verdict(chi2Time, ndfTime) << ")" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,137 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/RootOutputWriter.cc
+/// \brief Implementation of the B1::RootOutputWriter class
+
+#include "RootOutputWriter.hh"
+
+#include "OutputManifest.hh"
+#include "PMTDigi.hh"
+#include "PhotonBuffer.hh"
+
+#include "G4AnalysisManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RootOutputWriter::RootOutputWriter()
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+
+  fPhotonsNtupleID = analysisManager->CreateNtuple("Photons", "Detected photons");
+  analysisManager->CreateNtupleDColumn("Energy");
+  analysisManager->CreateNtupleDColumn("Time");
+  analysisManager->CreateNtupleIColumn("PMT");
+  analysisManager->CreateNtupleIColumn("EventID");
+  analysisManager->CreateNtupleIColumn("TrackID");
+  analysisManager->FinishNtuple();
+
+  // one row per PMT and event, see PMTDigitizer
+  fWaveformsNtupleID = analysisManager->CreateNtuple("Waveforms", "Digitized PMT waveforms");
+  analysisManager->CreateNtupleIColumn("EventID");
+  analysisManager->CreateNtupleIColumn("PMT");
+  analysisManager->CreateNtupleDColumn("Charge");
+  analysisManager->CreateNtupleFColumn("Samples", fWaveform);
+  analysisManager->FinishNtuple();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RootOutputWriter::SetNtupleMerging(G4bool merge, G4int nofReducedFiles)
+{
+  fNtupleMerging = merge;
+  G4AnalysisManager::Instance()->SetNtupleMerging(merge, nofReducedFiles);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RootOutputWriter::Open(const G4String& fileName, G4bool)
+{
+  // ntuples only: the histograms of the summary output stay empty
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->SetActivation(true);
+  analysisManager->SetNtupleActivation(true);
+  analysisManager->SetH1Activation(false);
+  analysisManager->SetH2Activation(false);
+
+  analysisManager->OpenFile(fileName + ".root");
+
+  // Without merging, every worker writes its own <fileName>_t<N>.root
+  if (!fNtupleMerging && G4Threading::IsWorkerThread()) {
+    OutputManifest::Instance().Add(
+      fileName + ".manifest",
+      fileName + "_t" + std::to_string(G4Threading::G4GetThreadId()) + ".root");
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RootOutputWriter::Close()
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->Write();
+  analysisManager->CloseFile();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RootOutputWriter::FillPhotons(G4int eventID, const PhotonBuffer& photons)
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+  const auto& energies = photons.GetEnergies();
+  const auto& times = photons.GetTimes();
+  const auto& pmtIDs = photons.GetPMTIDs();
+  const auto& trackIDs = photons.GetTrackIDs();
+  for (std::size_t k = 0; k < photons.Size(); ++k) {
+    analysisManager->FillNtupleDColumn(fPhotonsNtupleID, 0, energies[k] / eV);  // энергия eV
+    analysisManager->FillNtupleDColumn(fPhotonsNtupleID, 1, times[k] / ns);  // время ns
+    analysisManager->FillNtupleIColumn(fPhotonsNtupleID, 2, pmtIDs[k]);
+    analysisManager->FillNtupleIColumn(fPhotonsNtupleID, 3, eventID);
+    analysisManager->FillNtupleIColumn(fPhotonsNtupleID, 4, trackIDs[k]);
+    analysisManager->AddNtupleRow(fPhotonsNtupleID);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RootOutputWriter::FillWaveform(G4int eventID, const PMTDigi& digi)
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+  fWaveform = digi.GetSamples();
+  analysisManager->FillNtupleIColumn(fWaveformsNtupleID, 0, eventID);
+  analysisManager->FillNtupleIColumn(fWaveformsNtupleID, 1, digi.GetPMTID());
+  analysisManager->FillNtupleDColumn(fWaveformsNtupleID, 2, digi.GetCharge());
+  analysisManager->AddNtupleRow(fWaveformsNtupleID);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
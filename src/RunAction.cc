@@ -1,16 +1,24 @@
 #include "RunAction.hh"
 
+#include "AsyncOutput.hh"
+#include "ColumnarOutputWriter.hh"
 #include "DetectorConstruction.hh"
+#include "OutputManifest.hh"
+#include "PhotonMapGenerator.hh"
 #include "PrimaryGeneratorAction.hh"
+#include "RootOutputWriter.hh"
+#include "RunMonitor.hh"
+#include "SteppingAction.hh"
+#include "SummaryOutputWriter.hh"
 
 #include "G4AccumulableManager.hh"
-#include "G4LogicalVolume.hh"
+#include "G4GenericMessenger.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleGun.hh"
-#include "G4AnalysisManager.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
 #include "G4UnitsTable.hh"
 
 namespace B1
@@ -20,38 +28,75 @@ namespace B1
 
 RunAction::RunAction()
 {
-  auto analysisManager = G4AnalysisManager::Instance();
-
-  analysisManager->CreateNtuple("Photons", "Detected photons");
-  analysisManager->CreateNtupleDColumn("Energy");
-  analysisManager->CreateNtupleDColumn("Time");
-  analysisManager->FinishNtuple();
-  // add new units for dose
-  //
-  const G4double milligray = 1.e-3 * gray;
-  const G4double microgray = 1.e-6 * gray;
-  const G4double nanogray = 1.e-9 * gray;
-  const G4double picogray = 1.e-12 * gray;
-
-  new G4UnitDefinition("milligray", "milliGy", "Dose", milligray);
-  new G4UnitDefinition("microgray", "microGy", "Dose", microgray);
-  new G4UnitDefinition("nanogray", "nanoGy", "Dose", nanogray);
-  new G4UnitDefinition("picogray", "picoGy", "Dose", picogray);
+  fRootWriter = std::make_unique<RootOutputWriter>();
+  fColumnarWriter = std::make_unique<ColumnarOutputWriter>();
+  fSummaryWriter = std::make_unique<SummaryOutputWriter>(fPMTOccupancy);
+  DefineCommands();
 
   // Register accumulable to the accumulable manager
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Register(fEdep);
   accumulableManager->Register(fEdep2);
+  accumulableManager->Register(&fPhotonMap);
+  accumulableManager->Register(&fPMTOccupancy);
+  accumulableManager->Register(&fCullingValidation);
+  accumulableManager->Register(&fPhotonLimits);
+  accumulableManager->Register(&fStepProfiler);
+  accumulableManager->Register(&fTrigger);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void RunAction::BeginOfRunAction(const G4Run*)
+RunAction::~RunAction() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::BeginOfRunAction(const G4Run* run)
 {
-  auto analysisManager = G4AnalysisManager::Instance();
-  analysisManager->OpenFile("PhotonData.root");
   G4RunManager::GetRunManager()->SetRandomNumberStore(false);
 
+  // live monitoring: the master starts the reporting before the workers
+  // start the run
+  if (IsMaster() && RunMonitor::Instance()) RunMonitor::Instance()->BeginOfRun(run);
+
+  // the run ID is part of the key of the per-event random streams
+  if (IsMaster()) PrimaryGeneratorAction::SetRunID(run->GetRunID());
+
+  // Open the output of the selected backend. The columnar files are only
+  // written by the threads that process events, the summary histograms are
+  // merged by the master, and there is no event output in the photon map
+  // generation runs.
+  fWriter = nullptr;
+  if (fOutputFormat == "root") {
+    // ntuple merging can only be configured before the first file is opened
+    if (!fNtupleMergingSet && G4Threading::IsMultithreadedApplication()) {
+      fRootWriter->SetNtupleMerging(fMergeNtuples, fNofReducedFiles);
+      fNtupleMergingSet = true;
+    }
+    fWriter = fRootWriter.get();
+  }
+  else if (fOutputFormat == "summary") {
+    fWriter = fSummaryWriter.get();
+  }
+  else if (!(IsMaster() && G4Threading::IsMultithreadedApplication())) {
+    fWriter = fColumnarWriter.get();
+  }
+  if (PhotonMapGenerator::IsActive()) fWriter = nullptr;
+  if (fWriter) fWriter->Open(fFileName, fAppend);
+
+  // step profiling, optical photon limits and trigger, if set for this run
+  fStepProfiler.BeginOfRun();
+  fPhotonLimits.BeginOfRun();
+  fTrigger.BeginOfRun();
+
+  // (re)build the stepping dispatch table for the current geometry
+  if (fSteppingAction) {
+    fSteppingAction->BuildDispatchTable();
+    fSteppingAction->SetMonitorCounters(RunMonitor::GetThreadCounters());
+    fSteppingAction->SetProfiler(fStepProfiler.IsActive() ? &fStepProfiler : nullptr);
+    fSteppingAction->SetPhotonLimits(fPhotonLimits.IsActive() ? &fPhotonLimits : nullptr);
+  }
+
   // reset accumulables to their initial values
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Reset();
@@ -61,29 +106,36 @@ void RunAction::BeginOfRunAction(const G4Run*)
 
 void RunAction::EndOfRunAction(const G4Run* run)
 {
+  // Close the output also on threads that processed no events; the workers
+  // are done, so the master can list their files
+  if (fWriter) fWriter->Close();
+  fWriter = nullptr;
+  if (IsMaster()) OutputManifest::Instance().Write();
+  if (IsMaster() && AsyncOutput::Instance()) AsyncOutput::Instance()->EndOfRun();
+  if (IsMaster() && RunMonitor::Instance()) RunMonitor::Instance()->EndOfRun();
+
   G4int nofEvents = run->GetNumberOfEvent();
   if (nofEvents == 0) return;
 
   // Merge accumulables
+  fStepProfiler.EndOfRun();
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Merge();
+  if (IsMaster() && fStepProfiler.IsActive()) fStepProfiler.Report();
+
+  if (PhotonMapGenerator::IsActive()) {
+    if (IsMaster()) PhotonMapGenerator::Instance()->EndOfSlice(fPhotonMap);
+    return;
+  }
 
-  // Compute dose = total energy deposit in a run and its variance
+  // Energy of the detected photons per event, mean and rms
   //
   G4double edep = fEdep.GetValue();
   G4double edep2 = fEdep2.GetValue();
 
-  G4double rms = edep2 - edep * edep / nofEvents;
-  if (rms > 0.)
-    rms = std::sqrt(rms);
-  else
-    rms = 0.;
-
-  const auto detConstruction = static_cast<const DetectorConstruction*>(
-    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-  G4double mass = detConstruction->GetScoringVolume()->GetMass();
-  G4double dose = edep / mass;
-  G4double rmsDose = rms / mass;
+  G4double mean = edep / nofEvents;
+  G4double rms = edep2 / nofEvents - mean * mean;
+  rms = (rms > 0.) ? std::sqrt(rms) : 0.;
 
   // Run conditions
   //  note: There is no primary generator action object for "master"
@@ -91,7 +143,10 @@ void RunAction::EndOfRunAction(const G4Run* run)
   const auto generatorAction = static_cast<const PrimaryGeneratorAction*>(
     G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
   G4String runCondition;
-  if (generatorAction) {
+  if (generatorAction && generatorAction->IsIBDMode()) {
+    runCondition += "reactor IBD (e+ n)";
+  }
+  else if (generatorAction) {
     const G4ParticleGun* particleGun = generatorAction->GetParticleGun();
     runCondition += particleGun->GetParticleDefinition()->GetParticleName();
     runCondition += " of ";
@@ -99,10 +154,6 @@ void RunAction::EndOfRunAction(const G4Run* run)
     runCondition += G4BestUnit(particleEnergy, "Energy");
   }
 
-  auto analysisManager = G4AnalysisManager::Instance();
-  analysisManager->Write();
-  analysisManager->CloseFile();
-
   // Print
   //
   if (IsMaster()) {
@@ -113,9 +164,30 @@ void RunAction::EndOfRunAction(const G4Run* run)
   }
 
   G4cout << G4endl << " The run consists of " << nofEvents << " " << runCondition << G4endl
-         << " Cumulated dose per run, in scoring volume : " << G4BestUnit(dose, "Dose")
-         << " rms = " << G4BestUnit(rmsDose, "Dose") << G4endl
+         << " Detected photon energy per event : " << G4BestUnit(mean, "Energy")
+         << " rms = " << G4BestUnit(rms, "Energy") << G4endl
          << "------------------------------------------------------------" << G4endl << G4endl;
+
+  if (IsMaster() && fCullingValidation.GetNofEntries() > 0.) fCullingValidation.Print();
+  if (IsMaster() && fOutputFormat == "summary") fPMTOccupancy.Print();
+  if (IsMaster() && fPhotonLimits.IsActive()) fPhotonLimits.Print();
+  if (IsMaster() && fTrigger.IsActive()) fTrigger.Print();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::FillPhotons(G4int eventID, const PhotonBuffer& photons, G4bool writeRows)
+{
+  if (fWriter && (writeRows || fWriter == fSummaryWriter.get())) {
+    fWriter->FillPhotons(eventID, photons);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::FillWaveform(G4int eventID, const PMTDigi& digi)
+{
+  if (fWriter) fWriter->FillWaveform(eventID, digi);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -128,4 +200,47 @@ void RunAction::AddEdep(G4double edep)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void RunAction::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/output/", "Output control");
+
+  fMessenger->DeclareProperty("format", fOutputFormat)
+    .SetGuidance("Select the output backend:")
+    .SetGuidance("  root     : Photons and Waveforms ntuples (G4AnalysisManager)")
+    .SetGuidance("  columnar : flat columnar files, read with ColumnarReader.hh")
+    .SetGuidance("  summary  : histograms and per-PMT occupancy only, merged over")
+    .SetGuidance("             the threads (see SummaryOutputWriter.hh)")
+    .SetParameterName("format", false)
+    .SetCandidates("root columnar summary")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("fileName", fFileName)
+    .SetGuidance("Set the output file name, without extension.")
+    .SetParameterName("name", false)
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("mergeNtuples", fMergeNtuples)
+    .SetGuidance("Merge the worker ntuples into the master ROOT file(s) instead of")
+    .SetGuidance("writing one <fileName>_t<N>.root per thread and a manifest.")
+    .SetGuidance("Multi-threaded mode only; takes effect at the first run.")
+    .SetParameterName("merge", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("nofReducedFiles", fNofReducedFiles)
+    .SetGuidance("With ntuple merging, the number of files the workers write to")
+    .SetGuidance("in parallel (0 = a single file written by the master).")
+    .SetParameterName("nofFiles", false)
+    .SetRange("nofFiles>=0")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("append", fAppend)
+    .SetGuidance("Append to existing columnar files instead of overwriting them.")
+    .SetParameterName("append", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 }  // namespace B1
@@ -0,0 +1,385 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/RunMonitor.cc
+/// \brief Implementation of the B1::RunMonitor class
+
+#include "RunMonitor.hh"
+
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Run.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunMonitor::RunMonitor() : fThreads(kMaxThreads)
+{
+  fgInstance = this;
+  fInterval = 10. * s;
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunMonitor::~RunMonitor()
+{
+  EndOfRun();
+  fgInstance = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::int64_t RunMonitor::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunMonitor::ThreadCounters* RunMonitor::GetThreadCounters()
+{
+  if (!fgInstance || !fgInstance->fEnabled) return nullptr;
+  G4int slot = G4Threading::G4GetThreadId() + 1;
+  if (slot < 0 || slot >= kMaxThreads) return nullptr;
+
+  G4int nofSlots = fgInstance->fNofSlots.load();
+  while (nofSlots <= slot && !fgInstance->fNofSlots.compare_exchange_weak(nofSlots, slot + 1)) {
+  }
+  return &fgInstance->fThreads[slot];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::BeginEvent(ThreadCounters* counters, G4int eventID)
+{
+  counters->eventID.store(eventID, std::memory_order_relaxed);
+  counters->eventStart.store(Now(), std::memory_order_relaxed);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::EndEvent(ThreadCounters* counters)
+{
+  const std::int64_t start = counters->eventStart.load(std::memory_order_relaxed);
+  if (start < 0) return;
+  counters->busyTime.store(counters->busyTime.load(std::memory_order_relaxed) + Now() - start,
+                           std::memory_order_relaxed);
+  counters->eventStart.store(-1, std::memory_order_relaxed);
+  Increment(counters->events);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::BeginOfRun(const G4Run* run)
+{
+  EndOfRun();
+  if (!fEnabled) return;
+
+  // the workers have not started the run yet
+  for (auto& counters : fThreads) {
+    counters.events = 0;
+    counters.steps = 0;
+    counters.photonsCreated = 0;
+    counters.photonsTracked = 0;
+    counters.photonsDetected = 0;
+    counters.busyTime = 0;
+    counters.eventStart = -1;
+    counters.eventID = -1;
+    counters.writerStall = 0;
+  }
+  fRunID = run->GetRunID();
+  fNofEventsToProcess = run->GetNumberOfEventToBeProcessed();
+  fRunStart = Now();
+  fLastTime = fRunStart;
+  fLastTotals = Totals();
+  fLastBusy.assign(kMaxThreads, 0);
+
+  OpenSocket();
+  fStop = false;
+  fThread = std::thread(&RunMonitor::Report, this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::EndOfRun()
+{
+  if (!fThread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fCondition.notify_all();
+  fThread.join();
+  CloseSocket();
+
+  // run summary: the rates are averages over the run
+  fLastTime = fRunStart;
+  fLastTotals = Totals();
+  fLastBusy.assign(kMaxThreads, 0);
+  Write(Snapshot(false, true));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::Report()
+{
+  const auto interval = std::chrono::nanoseconds(static_cast<std::int64_t>(fInterval / ns));
+  auto next = std::chrono::steady_clock::now() + interval;
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (!fStop) {
+    if (fSocket >= 0) {
+      // requests are served between the checks of the stop flag
+      lock.unlock();
+      ServeRequests(100);
+      lock.lock();
+    }
+    else {
+      fCondition.wait_until(lock, next, [this] { return fStop; });
+    }
+    if (!fStop && std::chrono::steady_clock::now() >= next) {
+      Write(Snapshot(true));
+      next += interval;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::string RunMonitor::Snapshot(G4bool update, G4bool final)
+{
+  const std::int64_t now = Now();
+  const G4double elapsed = std::max(now - fLastTime, std::int64_t(1)) * 1e-9;
+
+  Totals totals;
+  G4int nofInEvent = 0;
+  std::ostringstream threads;
+  const G4int nofSlots = fNofSlots.load();
+  for (G4int slot = 0; slot < nofSlots; ++slot) {
+    const ThreadCounters& counters = fThreads[slot];
+    const std::uint64_t events = counters.events.load(std::memory_order_relaxed);
+    const std::int64_t start = counters.eventStart.load(std::memory_order_relaxed);
+    totals.events += events;
+    totals.steps += counters.steps.load(std::memory_order_relaxed);
+    totals.photonsCreated += counters.photonsCreated.load(std::memory_order_relaxed);
+    totals.photonsTracked += counters.photonsTracked.load(std::memory_order_relaxed);
+    totals.photonsDetected += counters.photonsDetected.load(std::memory_order_relaxed);
+    if (events == 0 && start < 0) continue;
+
+    // busy time including the event in progress
+    std::int64_t busy = counters.busyTime.load(std::memory_order_relaxed);
+    if (start >= 0) {
+      busy += now - start;
+      ++nofInEvent;
+    }
+    const G4double busyFraction = std::min((busy - fLastBusy[slot]) * 1e-9 / elapsed, 1.);
+    if (update) fLastBusy[slot] = busy;
+
+    threads << (threads.tellp() > 0 ? "," : "") << "{\"thread\":" << slot - 1
+            << ",\"events\":" << events << ",\"busy\":" << busyFraction
+            << ",\"writerStall\":" << counters.writerStall.load(std::memory_order_relaxed) * 1e-9;
+    if (start >= 0) {
+      threads << ",\"eventID\":" << counters.eventID.load(std::memory_order_relaxed)
+              << ",\"eventAge\":" << (now - start) * 1e-9;
+    }
+    threads << "}";
+  }
+
+  const G4int queued = std::max(
+    fNofEventsToProcess - static_cast<G4int>(totals.events) - nofInEvent, 0);
+  auto rate = [elapsed](std::uint64_t value, std::uint64_t last) {
+    return (value - last) / elapsed;
+  };
+
+  std::ostringstream line;
+  line << std::setprecision(6) << "{\"run\":" << fRunID << ",\"time\":" << (now - fRunStart) * 1e-9
+       << (final ? ",\"final\":true" : "") << ",\"events\":" << totals.events
+       << ",\"eventsToProcess\":" << fNofEventsToProcess << ",\"queued\":" << queued
+       << ",\"inProgress\":" << nofInEvent
+       << ",\"eventsPerSecond\":" << rate(totals.events, fLastTotals.events)
+       << ",\"stepsPerSecond\":" << rate(totals.steps, fLastTotals.steps)
+       << ",\"photonsCreatedPerSecond\":" << rate(totals.photonsCreated, fLastTotals.photonsCreated)
+       << ",\"photonsTrackedPerSecond\":" << rate(totals.photonsTracked, fLastTotals.photonsTracked)
+       << ",\"photonsDetectedPerSecond\":"
+       << rate(totals.photonsDetected, fLastTotals.photonsDetected) << ",\"threads\":["
+       << threads.str() << "]}";
+
+  if (update) {
+    fLastTime = now;
+    fLastTotals = totals;
+  }
+  return line.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::Write(const std::string& line) const
+{
+  // the reporting thread is not a Geant4 thread: no G4cout
+  if (fFileName.empty()) {
+    std::cout << line << std::endl;
+    return;
+  }
+  std::ofstream out(fFileName, std::ios::app);
+  out << line << '\n';
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef _WIN32
+
+void RunMonitor::OpenSocket()
+{
+  if (fSocketPath.empty()) return;
+
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (fSocketPath.size() >= sizeof(address.sun_path)) {
+    G4ExceptionDescription ed;
+    ed << "The socket path " << fSocketPath << " is too long; no socket.";
+    G4Exception("RunMonitor::OpenSocket()", "B1Monitor001", JustWarning, ed);
+    return;
+  }
+  std::copy(fSocketPath.begin(), fSocketPath.end(), address.sun_path);
+
+  fSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+  ::unlink(fSocketPath.c_str());  // left by a previous run or job
+  if (fSocket < 0 || bind(fSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+      || listen(fSocket, 8) != 0)
+  {
+    G4ExceptionDescription ed;
+    ed << "Cannot listen on the socket " << fSocketPath << "; no socket.";
+    G4Exception("RunMonitor::OpenSocket()", "B1Monitor002", JustWarning, ed);
+    CloseSocket();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::CloseSocket()
+{
+  if (fSocket < 0) return;
+  ::close(fSocket);
+  ::unlink(fSocketPath.c_str());
+  fSocket = -1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::ServeRequests(G4int timeout)
+{
+  pollfd request = {fSocket, POLLIN, 0};
+  if (poll(&request, 1, timeout) <= 0) return;
+  G4int client = accept(fSocket, nullptr, nullptr);
+  if (client < 0) return;
+
+  // any request gets the snapshot; what the client sent is discarded
+  char buffer[256];
+  pollfd input = {client, POLLIN, 0};
+  if (poll(&input, 1, 10) > 0) ::recv(client, buffer, sizeof(buffer), 0);
+  const std::string reply = Snapshot(false) + '\n';
+  ::send(client, reply.data(), reply.size(), MSG_NOSIGNAL);
+  ::close(client);
+}
+
+#else
+
+void RunMonitor::OpenSocket()
+{
+  if (fSocketPath.empty()) return;
+  G4ExceptionDescription ed;
+  ed << "Unix-domain sockets are not supported on this platform; no socket.";
+  G4Exception("RunMonitor::OpenSocket()", "B1Monitor003", JustWarning, ed);
+}
+
+void RunMonitor::CloseSocket() {}
+
+void RunMonitor::ServeRequests(G4int) {}
+
+#endif
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMonitor::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/monitor/",
+                                                    "Live throughput and progress of the runs");
+
+  fMessenger->DeclareProperty("enable", fEnabled)
+    .SetGuidance("Count the events, steps and optical photons of every thread and")
+    .SetGuidance("report the rates during the runs.")
+    .SetParameterName("enable", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("interval", "s", fInterval)
+    .SetGuidance("Time between two JSON lines.")
+    .SetParameterName("interval", false)
+    .SetRange("interval>0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("file", fFileName)
+    .SetGuidance("File the JSON lines are appended to (empty: standard output).")
+    .SetParameterName("fileName", true)
+    .SetDefaultValue("")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("socket", fSocketPath)
+    .SetGuidance("Unix-domain socket answering every connection with the current")
+    .SetGuidance("snapshot, during the runs (empty: no socket).")
+    .SetParameterName("path", true)
+    .SetDefaultValue("")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,296 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/SpectralDataLoader.cc
+/// \brief Implementation of the B1::SpectralDataLoader class
+
+#include "SpectralDataLoader.hh"
+
+#include "G4Exception.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include <unistd.h>
+
+namespace B1
+{
+
+namespace
+{
+constexpr char kMagic[8] = {'B', '1', 'S', 'P', 'E', 'C', 0, 0};
+// increment when Parse() or the cache layout change
+constexpr std::uint32_t kVersion = 1;
+
+struct CacheHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t nofPoints;
+    std::uint64_t hash;
+};
+
+const char* GetEnv(const char* name)
+{
+  const char* value = std::getenv(name);
+  return (value && *value) ? value : nullptr;
+}
+
+// hc = 1239.84198 eV nm (CODATA). The converter this loader replaces used
+// 1240 eV nm: the photon energies are 0.013% lower than with it.
+const G4double kHc = 1239.84198 * eV;
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SpectralDataLoader::SpectralDataLoader(const G4String& cacheDirectory)
+{
+  if (!cacheDirectory.empty()) {
+    fCacheDirectory = ResolvePath(cacheDirectory);
+  }
+  else if (auto b1CacheDir = GetEnv("B1_CACHE_DIR")) {
+    fCacheDirectory = b1CacheDir;
+  }
+  else if (auto xdgCacheHome = GetEnv("XDG_CACHE_HOME")) {
+    fCacheDirectory = G4String(xdgCacheHome) + "/exampleB1";
+  }
+  else if (auto home = GetEnv("HOME")) {
+    fCacheDirectory = G4String(home) + "/.cache/exampleB1";
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String SpectralDataLoader::ResolvePath(const G4String& path)
+{
+  std::string resolved;
+  std::size_t i = 0;
+  if (!path.empty() && path[0] == '~' && (path.size() == 1 || path[1] == '/')) {
+    if (auto home = GetEnv("HOME")) resolved = home;
+    i = 1;
+  }
+
+  while (i < path.size()) {
+    if (path[i] != '$') {
+      resolved += path[i++];
+      continue;
+    }
+    // $VAR or ${VAR}; an unset variable expands to nothing
+    std::size_t begin = i + 1;
+    std::size_t end = begin;
+    G4bool braces = begin < path.size() && path[begin] == '{';
+    if (braces) {
+      end = path.find('}', begin);
+      if (end == std::string::npos) {
+        resolved += path.substr(i);
+        break;
+      }
+      ++begin;
+    }
+    else {
+      while (end < path.size() && (std::isalnum(path[end]) || path[end] == '_')) ++end;
+    }
+    if (end == begin && !braces) {
+      resolved += path[i++];
+      continue;
+    }
+    if (auto value = GetEnv(path.substr(begin, end - begin).c_str())) resolved += value;
+    i = braces ? end + 1 : end;
+  }
+  return resolved;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::uint64_t SpectralDataLoader::Hash(const char* data, std::size_t size)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool SpectralDataLoader::Load(const G4String& fileName, std::vector<G4double>& energies,
+                                std::vector<G4double>& values) const
+{
+  G4String path = ResolvePath(fileName);
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    G4ExceptionDescription ed;
+    ed << "Cannot open the spectral data file " << fileName;
+    if (path != fileName) ed << " (" << path << ")";
+    ed << ".";
+    G4Exception("SpectralDataLoader::Load()", "B1Spectra001", JustWarning, ed);
+    return false;
+  }
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  std::uint64_t hash = Hash(content.data(), content.size());
+  if (ReadCache(hash, energies, values)) return true;
+
+  Parse(content.c_str(), content.size(), energies, values);
+  if (energies.empty()) {
+    G4ExceptionDescription ed;
+    ed << "No data in the spectral data file " << path << ".";
+    G4Exception("SpectralDataLoader::Load()", "B1Spectra002", JustWarning, ed);
+    return false;
+  }
+  WriteCache(hash, energies, values);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SpectralDataLoader::Parse(const char* data, std::size_t size,
+                               std::vector<G4double>& energies, std::vector<G4double>& values)
+{
+  // data is null-terminated, so that strtod() stops at the end
+  std::vector<std::pair<G4double, G4double>> points;
+  const char* p = data;
+  const char* end = data + size;
+  auto skipLine = [&]() {
+    auto eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    p = eol ? eol + 1 : end;
+  };
+
+  while (p < end) {
+    while (p < end && std::isspace(static_cast<unsigned char>(*p))) ++p;
+    if (p == end) break;
+    if (*p == '#') {
+      skipLine();
+      continue;
+    }
+
+    char* next = nullptr;
+    G4double wavelength = std::strtod(p, &next);
+    if (next == p) {
+      skipLine();
+      continue;
+    }
+    p = next;
+    G4double intensity = std::strtod(p, &next);
+    if (next == p) {
+      skipLine();
+      continue;
+    }
+    p = next;
+    skipLine();
+
+    if (wavelength > 0.) points.emplace_back(kHc / wavelength, intensity);
+  }
+
+  // sorted in energy, normalised to a maximum of 1
+  std::sort(points.begin(), points.end());
+  G4double maximum = 0.;
+  for (const auto& point : points) maximum = std::max(maximum, point.second);
+  if (maximum <= 0.) maximum = 1.;
+
+  energies.resize(points.size());
+  values.resize(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    energies[i] = points[i].first;
+    values[i] = points[i].second / maximum;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String SpectralDataLoader::GetCacheFileName(std::uint64_t hash) const
+{
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.b1spec", static_cast<unsigned long long>(hash));
+  return fCacheDirectory + "/" + name;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool SpectralDataLoader::ReadCache(std::uint64_t hash, std::vector<G4double>& energies,
+                                     std::vector<G4double>& values) const
+{
+  if (fCacheDirectory.empty()) return false;
+
+  std::ifstream in(GetCacheFileName(hash), std::ios::binary);
+  CacheHeader header;
+  if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header))
+      || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion
+      || header.hash != hash || header.nofPoints == 0)
+  {
+    return false;
+  }
+
+  energies.resize(header.nofPoints);
+  values.resize(header.nofPoints);
+  in.read(reinterpret_cast<char*>(energies.data()), energies.size() * sizeof(G4double));
+  in.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(G4double));
+  return static_cast<G4bool>(in);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SpectralDataLoader::WriteCache(std::uint64_t hash, const std::vector<G4double>& energies,
+                                    const std::vector<G4double>& values) const
+{
+  if (fCacheDirectory.empty()) return;
+
+  // the cache is an optimisation: failures are silent
+  std::error_code error;
+  std::filesystem::create_directories(fCacheDirectory.c_str(), error);
+  if (error) return;
+
+  CacheHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.nofPoints = static_cast<std::uint32_t>(energies.size());
+  header.hash = hash;
+
+  // write to a temporary file and rename, for concurrent jobs
+  G4String fileName = GetCacheFileName(hash);
+  G4String tmpName = fileName + ".tmp" + std::to_string(getpid());
+  std::ofstream out(tmpName, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(energies.data()), energies.size() * sizeof(G4double));
+  out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(G4double));
+  out.close();
+  if (!out || std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    std::remove(tmpName.c_str());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/SpectralTable.cc
+/// \brief Implementation of the B1::SpectralTable class
+
+#include "SpectralTable.hh"
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SpectralTable::SpectralTable(G4double eMin, G4double eMax, std::size_t nofPoints)
+  : fEMin(eMin),
+    fInvStep((nofPoints - 1) / (eMax - eMin)),
+    fXMax(static_cast<G4double>(nofPoints - 1)),
+    fEnergies(nofPoints),
+    fValues(nofPoints, 0.),
+    fSlopes(nofPoints, 0.)
+{
+  const G4double step = (eMax - eMin) / (nofPoints - 1);
+  for (std::size_t i = 0; i < nofPoints; ++i) {
+    fEnergies[i] = eMin + i * step;
+  }
+  fEnergies.back() = eMax;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SpectralTable::Fill(G4double value)
+{
+  std::fill(fValues.begin(), fValues.end(), value);
+  UpdateSlopes();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SpectralTable::Fill(const std::vector<G4double>& energies,
+                         const std::vector<G4double>& values, G4bool zeroOutside)
+{
+  if (energies.empty()) {
+    Fill(0.);
+    return;
+  }
+
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < fEnergies.size(); ++i) {
+    G4double e = fEnergies[i];
+    if (e < energies.front()) {
+      fValues[i] = zeroOutside ? 0. : values.front();
+      continue;
+    }
+    if (e > energies.back() || energies.size() == 1) {
+      fValues[i] = zeroOutside ? 0. : values.back();
+      continue;
+    }
+    // the grid is ascending, so the bracketing interval only moves forward
+    while (k + 2 < energies.size() && energies[k + 1] < e) ++k;
+    G4double de = energies[k + 1] - energies[k];
+    G4double t = (de > 0.) ? (e - energies[k]) / de : 0.;
+    fValues[i] = values[k] + t * (values[k + 1] - values[k]);
+  }
+  UpdateSlopes();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SpectralTable::Normalise()
+{
+  G4double maxValue = *std::max_element(fValues.begin(), fValues.end());
+  if (maxValue <= 0.) {
+    // all zeros: use a flat spectrum
+    std::fill(fValues.begin(), fValues.end(), 1.);
+  }
+  else {
+    for (auto& value : fValues) value /= maxValue;
+  }
+  UpdateSlopes();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SpectralTable::Values(const G4double* energies, G4double* values, std::size_t n) const
+{
+  const G4double* v = fValues.data();
+  const G4double* d = fSlopes.data();
+  for (std::size_t k = 0; k < n; ++k) {
+    G4double x = std::min(std::max((energies[k] - fEMin) * fInvStep, 0.), fXMax);
+    auto i = static_cast<std::size_t>(x);
+    values[k] = v[i] + (x - i) * d[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SpectralTable::UpdateSlopes()
+{
+  for (std::size_t i = 0; i + 1 < fValues.size(); ++i) {
+    fSlopes[i] = fValues[i + 1] - fValues[i];
+  }
+  if (!fSlopes.empty()) fSlopes.back() = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
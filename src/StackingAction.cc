@@ -0,0 +1,134 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/StackingAction.cc
+/// \brief Implementation of the B1::StackingAction class
+
+#include "StackingAction.hh"
+
+#include "OpticalSpectra.hh"
+#include "PhotonInformation.hh"
+#include "PhotonMapGenerator.hh"
+#include "TriggerEmulator.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4Track.hh"
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingAction::StackingAction() : fOpticalPhoton(G4OpticalPhoton::Definition())
+{
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingAction::~StackingAction() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  if (track->GetParticleDefinition() != fOpticalPhoton) return fUrgent;
+  if (fMonitor) RunMonitor::Increment(fMonitor->photonsCreated);
+
+  // the photon map is tabulated before the QE
+  if (!fEnabled || PhotonMapGenerator::IsActive()) return TrackPhoton();
+
+  G4bool accepted = fRandoms.Next() <= fQEScale * fQE->Value(track->GetTotalEnergy())
+                    && (fTimeWindow <= 0. || track->GetGlobalTime() < fTimeWindow);
+  if (!accepted && !fValidation) return fKill;
+
+  track->SetUserInformation(new PhotonInformation(accepted, fValidation, fTimeWindow));
+  return TrackPhoton();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ClassificationOfNewTrack StackingAction::TrackPhoton()
+{
+  if (fMonitor) RunMonitor::Increment(fMonitor->photonsTracked);
+  if (!fTrigger->UsesPhotonStage()) return fUrgent;
+
+  fTrigger->AddPhoton();
+  return fWaiting;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::NewStage()
+{
+  // the photons held back are the last tracks of the event
+  if (fTrigger->UsesPhotonStage()) fTrigger->BeginPhotonStage();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::PrepareNewEvent()
+{
+  // not in the constructor: in sequential mode, the user actions are built
+  // before the spectra data files can be selected
+  if (!fQE) fQE = &OpticalSpectra::Instance().GetQE();
+  fQEScale = OpticalSpectra::GetQEScale();
+  fRandoms.Clear();
+  fMonitor = RunMonitor::GetThreadCounters();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::DefineCommands()
+{
+  fMessenger = std::make_unique<G4GenericMessenger>(this, "/B1/stacking/",
+                                                    "Culling of the optical photons at birth");
+
+  fMessenger->DeclareProperty("enable", fEnabled)
+    .SetGuidance("Sample the photocathode QE when an optical photon is created and")
+    .SetGuidance("kill the rejected photons before they are tracked.")
+    .SetParameterName("enable", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclarePropertyWithUnit("timeWindow", "ns", fTimeWindow)
+    .SetGuidance("Kill the optical photons created after this time (0 = no cut).")
+    .SetParameterName("time", false)
+    .SetRange("time>=0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("validate", fValidation)
+    .SetGuidance("Track all photons and compare the spectra of the photons detected")
+    .SetGuidance("with the QE sampled at birth and at the photocathode.")
+    .SetParameterName("validate", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
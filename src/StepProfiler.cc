@@ -0,0 +1,289 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/StepProfiler.cc
+/// \brief Implementation of the B1::StepProfiler class
+
+#include "StepProfiler.hh"
+
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace B1
+{
+
+namespace
+{
+std::int64_t Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+template <class T>
+std::uint64_t IndexOf(std::vector<const T*>& objects, const T* object)
+{
+  auto it = std::find(objects.begin(), objects.end(), object);
+  if (it == objects.end()) it = objects.insert(objects.end(), object);
+  return static_cast<std::uint64_t>(it - objects.begin());
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepProfiler::StepProfiler() : G4VAccumulable("StepProfiler")
+{
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepProfiler::~StepProfiler() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::BeginOfRun()
+{
+  fActive = fEnabled;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::BeginTrack(const G4Track* track)
+{
+  // the track is located before the tracking action is called
+  fTrack = nullptr;
+  fLastTime = Now();
+  const G4VPhysicalVolume* volume = track->GetVolume();
+  if (volume) ++FindEntry(volume->GetLogicalVolume(), track).nofTracks;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Step(const G4Step* step)
+{
+  const std::int64_t now = Now();
+  const G4Track* track = step->GetTrack();
+  const G4LogicalVolume* volume = step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume();
+  // G4Track objects are recycled: BeginTrack() forgets the last track
+  if (track != fTrack || volume != fVolume) {
+    fEntry = &FindEntry(volume, track);
+    fTrack = track;
+    fVolume = volume;
+  }
+  ++fEntry->nofSteps;
+  fEntry->length += step->GetStepLength();
+  fEntry->wallTime += (now - fLastTime) * 1.e-9;
+  fLastTime = now;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepProfiler::Entry& StepProfiler::FindEntry(const G4LogicalVolume* volume, const G4Track* track)
+{
+  // node-based map: the entries do not move when it grows
+  std::uint64_t key = static_cast<std::uint64_t>(volume->GetInstanceID()) << 32
+                      | IndexOf(fParticles, track->GetParticleDefinition()) << 16
+                      | IndexOf(fProcesses, track->GetCreatorProcess());
+  return fTable[key];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::EndOfRun()
+{
+  if (fTable.empty()) return;
+
+  // the geometry and the processes are unchanged until the end of the run
+  std::unordered_map<G4int, std::string> volumeNames;
+  for (auto volume : *G4LogicalVolumeStore::GetInstance()) {
+    volumeNames[volume->GetInstanceID()] = volume->GetName();
+  }
+
+  for (const auto& [key, entry] : fTable) {
+    const auto process = fProcesses[key & 0xffff];
+    Key names(volumeNames[static_cast<G4int>(key >> 32)],
+              fParticles[(key >> 16) & 0xffff]->GetParticleName(),
+              process ? process->GetProcessName() : "primary");
+    Entry& merged = fEntries[names];
+    merged.nofSteps += entry.nofSteps;
+    merged.nofTracks += entry.nofTracks;
+    merged.length += entry.length;
+    merged.wallTime += entry.wallTime;
+  }
+  fTable.clear();
+  fTrack = nullptr;
+  fVolume = nullptr;
+  fEntry = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Merge(const G4VAccumulable& other)
+{
+  const auto& otherProfiler = static_cast<const StepProfiler&>(other);
+  for (const auto& [key, entry] : otherProfiler.fEntries) {
+    Entry& merged = fEntries[key];
+    merged.nofSteps += entry.nofSteps;
+    merged.nofTracks += entry.nofTracks;
+    merged.length += entry.length;
+    merged.wallTime += entry.wallTime;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Reset()
+{
+  fTable.clear();
+  fParticles.clear();
+  fProcesses.clear();
+  fTrack = nullptr;
+  fVolume = nullptr;
+  fEntry = nullptr;
+  fEntries.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<std::pair<StepProfiler::Key, StepProfiler::Entry>> StepProfiler::Sorted() const
+{
+  std::vector<std::pair<Key, Entry>> entries(fEntries.begin(), fEntries.end());
+  std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a.second.wallTime > b.second.wallTime;
+  });
+  return entries;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Report() const
+{
+  if (fEntries.empty()) return;
+  Print();
+  Write();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Print(G4PrintOptions) const
+{
+  const auto entries = Sorted();
+  Entry total;
+  for (const auto& [key, entry] : entries) {
+    total.nofSteps += entry.nofSteps;
+    total.nofTracks += entry.nofTracks;
+    total.wallTime += entry.wallTime;
+  }
+
+  G4cout << G4endl << " Step profile: " << total.nofSteps << " steps, " << total.nofTracks
+         << " tracks, " << total.wallTime << " s in the tracking" << G4endl << "  "
+         << std::left << std::setw(16) << "volume" << std::setw(14) << "particle"
+         << std::setw(16) << "creator" << std::right << std::setw(12) << "steps"
+         << std::setw(11) << "tracks" << std::setw(12) << "length [m]" << std::setw(11)
+         << "time [s]" << std::setw(8) << "time %" << G4endl;
+
+  const auto nofRows = std::min(entries.size(), static_cast<std::size_t>(std::max(fNofRows, 0)));
+  for (std::size_t i = 0; i < nofRows; ++i) {
+    const auto& [key, entry] = entries[i];
+    G4double fraction = (total.wallTime > 0.) ? 100. * entry.wallTime / total.wallTime : 0.;
+    G4cout << "  " << std::left << std::setw(16) << std::get<0>(key) << std::setw(14)
+           << std::get<1>(key) << std::setw(16) << std::get<2>(key) << std::right
+           << std::setw(12) << entry.nofSteps << std::setw(11) << entry.nofTracks
+           << std::setw(12) << std::setprecision(4) << entry.length / m << std::setw(11)
+           << entry.wallTime << std::setw(8) << std::setprecision(3) << fraction
+           << std::setprecision(6) << G4endl;
+  }
+  if (nofRows < entries.size()) {
+    G4cout << "  ... " << entries.size() - nofRows << " more in " << fFileName << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Write() const
+{
+  if (fFileName.empty()) return;
+
+  std::ofstream out(fFileName);
+  if (!out) {
+    G4ExceptionDescription ed;
+    ed << "Cannot write the step profile to " << fFileName << ".";
+    G4Exception("StepProfiler::Write()", "B1Profile001", JustWarning, ed);
+    return;
+  }
+  out << "volume,particle,creator,steps,tracks,length_mm,time_s\n" << std::setprecision(9);
+  for (const auto& [key, entry] : Sorted()) {
+    out << std::get<0>(key) << ',' << std::get<1>(key) << ',' << std::get<2>(key) << ','
+        << entry.nofSteps << ',' << entry.nofTracks << ',' << entry.length / mm << ','
+        << entry.wallTime << '\n';
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::DefineCommands()
+{
+  fMessenger =
+    std::make_unique<G4GenericMessenger>(this, "/B1/profile/", "Step and time profiling");
+
+  fMessenger->DeclareProperty("enable", fEnabled)
+    .SetGuidance("Count the steps, tracks, track length and wall time per")
+    .SetGuidance("(logical volume, particle, creator process) in the next runs.")
+    .SetParameterName("enable", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("fileName", fFileName)
+    .SetGuidance("Set the CSV file of the profile written at the end of the run")
+    .SetGuidance("(empty: no file).")
+    .SetParameterName("name", false)
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("nofRows", fNofRows)
+    .SetGuidance("Set the number of entries printed at the end of the run,")
+    .SetGuidance("sorted by wall time.")
+    .SetParameterName("nofRows", false)
+    .SetRange("nofRows>=0")
+    .SetStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -1,77 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/SteppingAction.cc
+/// \brief Implementation of the B1::SteppingAction class
+
 #include "SteppingAction.hh"
-#include "EventAction.hh"
-#include "DetectorConstruction.hh"
 
-#include "G4Step.hh"
-#include "G4Track.hh"
+#include "PhotonLimits.hh"
+#include "StepProfiler.hh"
+
 #include "G4LogicalVolume.hh"
-#include "G4RunManager.hh"
-#include "G4SystemOfUnits.hh"
-#include "G4AnalysisManager.hh"
-#include "Randomize.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4Step.hh"
 
-namespace B1 {
+#include <algorithm>
 
-SteppingAction::SteppingAction(EventAction* eventAction)
- : G4UserSteppingAction(),
-   fEventAction(eventAction),
-   fScoringVolume(nullptr)
+namespace B1
 {
-    fNumQEPoints = 23;
-    G4double photonEnergy_eV[23] = {2.175, 2.214, 2.254, 2.296,
-                                    2.339, 2.384, 2.431, 2.480,
-                                    2.530, 2.583, 2.638, 2.695,
-                                    2.755, 2.818, 2.883, 2.952,
-                                    3.024, 3.100, 3.179, 3.263,
-                                    3.351, 3.444, 3.542};
-    G4double QE[23];
-    for (int i=0; i<23; i++) QE[i] = 0.28;
-
-    fPhotonEnergies.assign(photonEnergy_eV, photonEnergy_eV + 23);
-    fQE.assign(QE, QE + 23);
-}
 
-G4double SteppingAction::GetQE(G4double energy)
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SteppingAction::BuildDispatchTable()
 {
-    G4double minDiff = std::abs(fPhotonEnergies[0] - energy);
-    int idx = 0;
-    for (int i=1; i<fNumQEPoints; ++i) {
-        G4double diff = std::abs(fPhotonEnergies[i] - energy);
-        if (diff < minDiff) {
-            minDiff = diff;
-            idx = i;
-        }
-    }
-    return fQE[idx];
+  fOpticalPhoton = G4OpticalPhoton::Definition();
+
+  // Logical volume instance IDs are dense and stay valid until the
+  // geometry is rebuilt, which is why the table is refreshed every run
+  G4int maxID = -1;
+  for (auto volume : *G4LogicalVolumeStore::GetInstance()) {
+    maxID = std::max(maxID, volume->GetInstanceID());
+  }
+  fNofVolumes = static_cast<std::size_t>(maxID + 1);
+  fTable.assign(kNofParticleSlots * fNofVolumes, nullptr);
+  for (auto& active : fSlotActive) active = false;
+
+  // No handler is registered here: the photons are scored by PMTSD.
+  // Handlers for the volumes of the detector are added with SetHandler()
 }
 
-void SteppingAction::UserSteppingAction(const G4Step* step)
-{
-    if (!fScoringVolume) {
-        const auto detConstruction = static_cast<const DetectorConstruction*>(
-            G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-        fScoringVolume = detConstruction->GetScoringVolume();
-    }
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-    G4LogicalVolume* volume = step->GetPreStepPoint()->GetTouchableHandle()
-                              ->GetVolume()->GetLogicalVolume();
+void SteppingAction::SetHandler(ParticleSlot slot, const G4LogicalVolume* volume, Handler handler)
+{
+  if (!volume) return;
+  auto id = static_cast<std::size_t>(volume->GetInstanceID());
+  fTable[slot * fNofVolumes + id] = handler;
+  fSlotActive[slot] = true;
+}
 
-    G4Track* track = step->GetTrack();
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-    if (track->GetDefinition()->GetParticleName() != "opticalphoton") return;
-    if (!(volume == fScoringVolume)) return;
+void SteppingAction::UserSteppingAction(const G4Step* step)
+{
+  if (fMonitor) RunMonitor::Increment(fMonitor->steps);
+  if (fProfiler) fProfiler->Step(step);
 
-    G4double Ephoton = track->GetKineticEnergy();
-    G4double prob = GetQE(Ephoton/eV);
-    if (G4UniformRand() > prob) return;
+  const ParticleSlot slot =
+    (step->GetTrack()->GetParticleDefinition() == fOpticalPhoton) ? kOpticalPhoton : kOtherParticle;
+  if (slot == kOpticalPhoton && fPhotonLimits) fPhotonLimits->Check(step);
+  if (!fSlotActive[slot]) return;
 
-    G4double time = track->GetGlobalTime();
-    auto analysisManager = G4AnalysisManager::Instance();
-    analysisManager->FillNtupleDColumn(0, Ephoton/eV); // энергия eV
-    analysisManager->FillNtupleDColumn(1, time/ns);    // время ns
-    analysisManager->AddNtupleRow();
+  const G4LogicalVolume* volume = step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume();
+  auto id = static_cast<std::size_t>(volume->GetInstanceID());
+  if (id >= fNofVolumes) return;
 
-    fEventAction->AddEdep(Ephoton);
+  Handler handler = fTable[slot * fNofVolumes + id];
+  if (handler) (this->*handler)(step);
 }
 
-} // namespace B1
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/SummaryOutputWriter.cc
+/// \brief Implementation of the B1::SummaryOutputWriter class
+
+#include "SummaryOutputWriter.hh"
+
+#include "PMTDigi.hh"
+#include "PMTOccupancy.hh"
+#include "PhotonBuffer.hh"
+
+#include "G4AnalysisManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SummaryOutputWriter::SummaryOutputWriter(PMTOccupancy& occupancy) : fOccupancy(occupancy)
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+
+  // same ranges as the QE culling validation spectra
+  fEnergyH1ID = analysisManager->CreateH1("Energy", "Detected photon energy (eV)", 80, 2.0, 3.6);
+  fTimeH1ID = analysisManager->CreateH1("Time", "Detected photon time (ns)", 200, 0., 200.);
+  fPhotoelectronsH1ID =
+    analysisManager->CreateH1("Photoelectrons", "Photoelectrons per event", 500, 0., 5000.);
+  fChargeH1ID = analysisManager->CreateH1("Charge", "PMT waveform charge (p.e.)", 200, 0., 200.);
+  fEnergyTimeH2ID = analysisManager->CreateH2(
+    "EnergyVsTime", "Detected photon energy (eV) vs time (ns)", 40, 2.0, 3.6, 100, 0., 200.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SummaryOutputWriter::Open(const G4String& fileName, G4bool)
+{
+  // histograms only, see RootOutputWriter::Open()
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->SetActivation(true);
+  analysisManager->SetNtupleActivation(false);
+  analysisManager->SetH1Activation(true);
+  analysisManager->SetH2Activation(true);
+
+  analysisManager->OpenFile(fileName + ".root");
+  fFileName = fileName;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SummaryOutputWriter::Close()
+{
+  // the workers have merged their PMT occupancy when the master closes
+  if (G4Threading::IsMasterThread() && fOccupancy.GetNofEvents() > 0.) {
+    fOccupancy.Write(fFileName + "_pmt.csv");
+  }
+
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->Write();
+  analysisManager->CloseFile();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SummaryOutputWriter::FillPhotons(G4int, const PhotonBuffer& photons)
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+  const auto& energies = photons.GetEnergies();
+  const auto& times = photons.GetTimes();
+  for (std::size_t k = 0; k < photons.Size(); ++k) {
+    analysisManager->FillH1(fEnergyH1ID, energies[k] / eV);
+    analysisManager->FillH1(fTimeH1ID, times[k] / ns);
+    analysisManager->FillH2(fEnergyTimeH2ID, energies[k] / eV, times[k] / ns);
+  }
+  analysisManager->FillH1(fPhotoelectronsH1ID, static_cast<G4double>(photons.Size()));
+  fOccupancy.Fill(photons);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SummaryOutputWriter::FillWaveform(G4int, const PMTDigi& digi)
+{
+  G4AnalysisManager::Instance()->FillH1(fChargeH1ID, digi.GetCharge());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1
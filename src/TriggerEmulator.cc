@@ -0,0 +1,234 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1/src/TriggerEmulator.cc
+/// \brief Implementation of the B1::TriggerEmulator class
+
+#include "TriggerEmulator.hh"
+
+#include "PhotonMapGenerator.hh"
+
+#include "G4EventManager.hh"
+#include "G4Exception.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+
+namespace B1
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TriggerEmulator::TriggerEmulator() : G4VAccumulable("TriggerEmulator")
+{
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TriggerEmulator::~TriggerEmulator() = default;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::BeginOfRun()
+{
+  // no trigger on the photon map generation runs
+  fActive = fEnabled && !PhotonMapGenerator::IsActive();
+  if (fActive && fMinPhotoelectrons <= 0 && fMinPMTs <= 0) {
+    G4ExceptionDescription ed;
+    ed << "No trigger threshold is set: the trigger emulation is off.";
+    G4Exception("TriggerEmulator::BeginOfRun()", "B1Trigger001", JustWarning, ed);
+    fActive = false;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::BeginEvent()
+{
+  fNofPhotoelectrons = 0;
+  fNofHitPMTs = 0;
+  std::fill(fHitPMTs.begin(), fHitPMTs.end(), 0);
+  fNofPendingPhotons = 0;
+  fPhotonStage = false;
+  fAccepted = false;
+  fStopped = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::EndPhoton()
+{
+  --fNofPendingPhotons;
+  if (fPhotonStage && !fAccepted && !fStopped && IsHopeless()) Stop(fNofStoppedHopeless);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::BeginPhotonStage()
+{
+  fPhotonStage = true;
+  if (!fAccepted && !fStopped && IsHopeless()) Stop(fNofStoppedHopeless);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::AddPhotoelectron(G4int pmtID, G4double time)
+{
+  if (fAccepted || (fWindow > 0. && time >= fWindow)) return;
+
+  ++fNofPhotoelectrons;
+  if (pmtID >= static_cast<G4int>(fHitPMTs.size())) fHitPMTs.resize(pmtID + 1, 0);
+  if (!fHitPMTs[pmtID]) {
+    fHitPMTs[pmtID] = 1;
+    ++fNofHitPMTs;
+  }
+
+  fAccepted = (fMinPhotoelectrons > 0 && fNofPhotoelectrons >= fMinPhotoelectrons)
+              || (fMinPMTs > 0 && fNofHitPMTs >= fMinPMTs);
+  if (fAccepted && fStopWhenAccepted && !fStopped) Stop(fNofStoppedAccepted);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::EndEvent()
+{
+  fNofEvents += 1.;
+  if (fAccepted) fNofAccepted += 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool TriggerEmulator::IsHopeless() const
+{
+  // each pending photon gives at most one photoelectron, on one PMT
+  if (!fStopWhenHopeless) return false;
+  G4long nofPhotons = std::max(fNofPendingPhotons, G4long(0));
+  G4bool photoelectronsHopeless =
+    fMinPhotoelectrons <= 0 || fNofPhotoelectrons + nofPhotons < fMinPhotoelectrons;
+  G4bool pmtsHopeless = fMinPMTs <= 0 || fNofHitPMTs + nofPhotons < fMinPMTs;
+  return photoelectronsHopeless && pmtsHopeless;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::Stop(G4double& counter)
+{
+  fStopped = true;
+  counter += 1.;
+  G4EventManager::GetEventManager()->AbortCurrentEvent();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::Merge(const G4VAccumulable& other)
+{
+  const auto& otherTrigger = static_cast<const TriggerEmulator&>(other);
+  fNofEvents += otherTrigger.fNofEvents;
+  fNofAccepted += otherTrigger.fNofAccepted;
+  fNofStoppedAccepted += otherTrigger.fNofStoppedAccepted;
+  fNofStoppedHopeless += otherTrigger.fNofStoppedHopeless;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::Reset()
+{
+  fNofEvents = 0.;
+  fNofAccepted = 0.;
+  fNofStoppedAccepted = 0.;
+  fNofStoppedHopeless = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::Print(G4PrintOptions) const
+{
+  G4double efficiency = (fNofEvents > 0.) ? fNofAccepted / fNofEvents : 0.;
+
+  G4cout << G4endl << " Trigger (";
+  if (fMinPhotoelectrons > 0) G4cout << ">= " << fMinPhotoelectrons << " p.e.";
+  if (fMinPhotoelectrons > 0 && fMinPMTs > 0) G4cout << " or ";
+  if (fMinPMTs > 0) G4cout << ">= " << fMinPMTs << " PMTs";
+  if (fWindow > 0.) G4cout << " within " << fWindow / ns << " ns";
+  G4cout << "): " << fNofAccepted << " of " << fNofEvents << " events accepted (efficiency "
+         << efficiency << ")" << G4endl << "   stopped once accepted: " << fNofStoppedAccepted
+         << ", stopped as hopeless: " << fNofStoppedHopeless << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TriggerEmulator::DefineCommands()
+{
+  fMessenger =
+    std::make_unique<G4GenericMessenger>(this, "/B1/trigger/", "Trigger emulation");
+
+  fMessenger->DeclareProperty("enable", fEnabled)
+    .SetGuidance("Emulate the trigger decision of each event.")
+    .SetParameterName("enable", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("minPhotoelectrons", fMinPhotoelectrons)
+    .SetGuidance("Accept the events with at least this number of photoelectrons")
+    .SetGuidance("within the window (0 = not used).")
+    .SetParameterName("nofPhotoelectrons", false)
+    .SetRange("nofPhotoelectrons>=0")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("minPMTs", fMinPMTs)
+    .SetGuidance("Accept the events with at least this number of PMTs hit")
+    .SetGuidance("within the window (0 = not used).")
+    .SetParameterName("nofPMTs", false)
+    .SetRange("nofPMTs>=0")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclarePropertyWithUnit("window", "ns", fWindow)
+    .SetGuidance("Count the photoelectrons detected before this global time")
+    .SetGuidance("(0 = whole event).")
+    .SetParameterName("time", false)
+    .SetRange("time>=0.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("stopWhenAccepted", fStopWhenAccepted)
+    .SetGuidance("Abort the event as soon as it is accepted.")
+    .SetParameterName("stop", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("stopWhenHopeless", fStopWhenHopeless)
+    .SetGuidance("Abort the event as soon as the photons still to be tracked")
+    .SetGuidance("cannot reach the thresholds. The optical photons are then")
+    .SetGuidance("tracked after all the other particles.")
+    .SetParameterName("stop", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}  // namespace B1